@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file benchmarks.hpp
+ * @brief The benchmarks of hailo-ollama-bench
+ **/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// each takes the arguments after its name and returns the exit code
+
+// pull throughput by number of connections from a local range server
+int download_benchmark(const std::vector<std::string>& arguments);
+
+// hashing throughput of a blob file by read strategy
+int sha256_benchmark(const std::vector<std::string>& arguments);
+
+// more connections than the limit, checked for 503s and a bounded thread count
+int connections_benchmark(const std::vector<std::string>& arguments);
+
+// streamed token latency of a running server, Unix socket against TCP
+int latency_benchmark(const std::vector<std::string>& arguments);
+
+// log call latency while the log writer is blocked on stdout
+int logger_benchmark(const std::vector<std::string>& arguments);
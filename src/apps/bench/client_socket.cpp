@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file client_socket.cpp
+ * @brief Socket implementation
+ **/
+
+#include "client_socket.hpp"
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace {
+void set_receive_timeout(const Socket& socket, std::chrono::seconds timeout) {
+    timeval value {static_cast<time_t>(timeout.count()), 0};
+    (void)setsockopt(
+        socket.get(),
+        SOL_SOCKET,
+        SO_RCVTIMEO,
+        &value,
+        sizeof(value)
+    );
+}
+}  // namespace
+
+Socket::Socket(int fd) : m_fd(fd) {}
+
+Socket::~Socket() {
+    if (m_fd >= 0) {
+        (void)close(m_fd);
+    }
+}
+
+Socket::Socket(Socket&& other) noexcept : m_fd(other.m_fd) {
+    other.m_fd = -1;
+}
+
+int Socket::get() const {
+    return m_fd;
+}
+
+void Socket::send_all(const std::string& data) const {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const auto count =
+            send(m_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            throw std::system_error(errno, std::generic_category(), "send");
+        }
+        sent += static_cast<size_t>(count);
+    }
+}
+
+Socket connect_tcp(
+    const std::string& host,
+    const std::string& port,
+    std::chrono::seconds timeout
+) {
+    addrinfo hints {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    const auto result =
+        getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses);
+    if (result != 0) {
+        throw std::runtime_error(
+            "failed to resolve " + host + ": " + gai_strerror(result)
+        );
+    }
+    int error = ECONNREFUSED;
+    for (auto* address = addresses; address; address = address->ai_next) {
+        Socket socket(::socket(
+            address->ai_family,
+            address->ai_socktype | SOCK_CLOEXEC,
+            address->ai_protocol
+        ));
+        if (socket.get() >= 0
+            && connect(socket.get(), address->ai_addr, address->ai_addrlen)
+                == 0) {
+            freeaddrinfo(addresses);
+            set_receive_timeout(socket, timeout);
+            return socket;
+        }
+        error = errno;
+    }
+    freeaddrinfo(addresses);
+    throw std::system_error(error, std::generic_category(), "connect");
+}
+
+Socket connect_unix(const std::string& path, std::chrono::seconds timeout) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("socket path too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    Socket socket(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (socket.get() < 0
+        || connect(
+               socket.get(),
+               reinterpret_cast<const sockaddr*>(&address),
+               sizeof(address)
+           ) != 0) {
+        throw std::system_error(
+            errno,
+            std::generic_category(),
+            "connect " + path
+        );
+    }
+    set_receive_timeout(socket, timeout);
+    return socket;
+}
@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file client_socket.hpp
+ * @brief Blocking client sockets for the benchmarks which talk raw HTTP
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+class Socket {
+  public:
+    explicit Socket(int fd);
+    ~Socket();
+    Socket(Socket&& other) noexcept;
+    Socket& operator=(Socket&&) = delete;
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    int get() const;
+    // throws std::system_error unless all of data was sent
+    void send_all(const std::string& data) const;
+
+  private:
+    int m_fd;
+};
+
+// reads fail with EAGAIN after the timeout; both throw std::system_error
+Socket connect_tcp(
+    const std::string& host,
+    const std::string& port,
+    std::chrono::seconds timeout
+);
+Socket connect_unix(const std::string& path, std::chrono::seconds timeout);
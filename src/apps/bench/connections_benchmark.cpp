@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file connections_benchmark.cpp
+ * @brief More connections than the server takes, checked for 503s and threads
+ **/
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <oatpp/web/server/HttpConnectionHandler.hpp>
+#include <oatpp/web/server/HttpRouter.hpp>
+
+#include "benchmarks.hpp"
+#include "client_socket.hpp"
+#include "controller/metrics_controller.hpp"
+#include "local_server.hpp"
+#include "metrics/server_metrics.hpp"
+#include "network/server_connection.hpp"
+#include "options.hpp"
+
+namespace {
+constexpr auto response_timeout = std::chrono::seconds(5);
+constexpr auto accept_wait = std::chrono::milliseconds(500);
+// the server's own threads besides the ones of the connections
+constexpr int64_t spare_threads = 8;
+
+// the status code of the response, std::nullopt if the server closed the
+// connection or sent nothing
+std::optional<int> read_status(const Socket& socket) {
+    // "HTTP/1.1 200" is enough, the rest of the response is left unread
+    std::string line;
+    char buffer[64];
+    while (line.size() < 12) {
+        const auto count = recv(socket.get(), buffer, sizeof(buffer), 0);
+        if (count <= 0) {
+            return std::nullopt;
+        }
+        line.append(buffer, static_cast<size_t>(count));
+    }
+    if (line.rfind("HTTP/1.", 0) != 0) {
+        return std::nullopt;
+    }
+    return std::stoi(line.substr(9, 3));
+}
+
+// of the process with the given pid, 0 for this one
+int64_t thread_count(int64_t pid) {
+    std::ifstream status(
+        pid == 0 ? "/proc/self/status"
+                 : "/proc/" + std::to_string(pid) + "/status"
+    );
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("Threads:", 0) == 0) {
+            return std::stoll(line.substr(8));
+        }
+    }
+    throw std::runtime_error("no thread count for pid " + std::to_string(pid));
+}
+
+struct Result {
+    int64_t served = 0;
+    int64_t rejected = 0;
+    int64_t failed = 0;
+    int64_t threads = 0;
+};
+
+Result run_connections(
+    const std::string& host,
+    const std::string& port,
+    const std::string& path,
+    int64_t connections,
+    int64_t pid
+) {
+    // all connections are open before any response is read, so each one the
+    // server takes holds a thread until the end
+    std::vector<Socket> sockets;
+    sockets.reserve(connections);
+    for (int64_t i = 0; i < connections; ++i) {
+        sockets.push_back(connect_tcp(host, port, response_timeout));
+    }
+    // the server sends its 503 right after the accept; a request sent to a
+    // rejected connection could turn the close into a reset which loses it
+    std::this_thread::sleep_for(accept_wait);
+    const auto request = "GET " + path + " HTTP/1.1\r\nHost: " + host
+        + "\r\nConnection: keep-alive\r\n\r\n";
+    Result result;
+    for (const auto& socket : sockets) {
+        pollfd readable {socket.get(), POLLIN, 0};
+        if (poll(&readable, 1, 0) == 0) {
+            try {
+                socket.send_all(request);
+            } catch (const std::system_error&) {
+                // closed by the server, counted as failed below
+            }
+        }
+        const auto status = read_status(socket);
+        if (status == 503) {
+            ++result.rejected;
+        } else if (status) {
+            ++result.served;
+        } else {
+            ++result.failed;
+        }
+    }
+    result.threads = pid >= 0 ? thread_count(pid) : -1;
+    return result;
+}
+}  // namespace
+
+int connections_benchmark(const std::vector<std::string>& arguments) {
+    const Options options(
+        arguments,
+        {"--max-connections", "--connections", "--server", "--path", "--pid"}
+    );
+    const auto max_connections = options.get_int("--max-connections", 16);
+    const auto connections =
+        options.get_int("--connections", 4 * max_connections);
+    if (max_connections < 1 || connections <= max_connections) {
+        throw std::invalid_argument(
+            "--connections must be above --max-connections"
+        );
+    }
+
+    const auto remote = options.get("--server", "");
+    Result result;
+    int64_t baseline = -1;
+    if (!remote.empty()) {
+        // a running hailo-ollama with server.max_connections set to
+        // --max-connections; threads are only counted with its --pid
+        const auto colon = remote.rfind(':');
+        if (colon == std::string::npos) {
+            throw std::invalid_argument("--server takes host:port");
+        }
+        const auto pid = options.get_int("--pid", -1);
+        baseline = pid >= 0 ? thread_count(pid) : -1;
+        result = run_connections(
+            remote.substr(0, colon),
+            remote.substr(colon + 1),
+            options.get("--path", "/api/version"),
+            connections,
+            pid
+        );
+    } else {
+        ListenOptions listen;
+        listen.limiter = std::make_shared<ConnectionLimiter>(
+            static_cast<size_t>(max_connections)
+        );
+        uint16_t port = 0;
+        auto provider = listen_loopback(port, listen);
+        auto router = oatpp::web::server::HttpRouter::createShared();
+        router->addController(
+            std::make_shared<MetricsController>(
+                std::make_shared<ServerMetrics>(),
+                make_content_mappers()
+            )
+        );
+        const LocalServer server(
+            provider,
+            oatpp::web::server::HttpConnectionHandler::createShared(router)
+        );
+        baseline = thread_count(0);
+        result = run_connections(
+            "127.0.0.1",
+            std::to_string(port),
+            "/metrics",
+            connections,
+            0
+        );
+    }
+
+    std::printf(
+        "%lld connections, at most %lld taken: %lld served, %lld got 503, "
+        "%lld failed\n",
+        static_cast<long long>(connections),
+        static_cast<long long>(max_connections),
+        static_cast<long long>(result.served),
+        static_cast<long long>(result.rejected),
+        static_cast<long long>(result.failed)
+    );
+    auto passed = result.served <= max_connections
+        && result.served + result.rejected == connections;
+    if (baseline >= 0) {
+        std::printf(
+            "threads: %lld before, %lld with all connections open\n",
+            static_cast<long long>(baseline),
+            static_cast<long long>(result.threads)
+        );
+        passed = passed
+            && result.threads <= baseline + max_connections + spare_threads;
+    }
+    std::printf("%s\n", passed ? "PASS" : "FAIL");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file download_benchmark.cpp
+ * @brief Pull throughput by number of connections
+ **/
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <oatpp/web/server/HttpConnectionHandler.hpp>
+#include <oatpp/web/server/HttpRouter.hpp>
+
+#include "benchmarks.hpp"
+#include "config/runtime_config.hpp"
+#include "controller/blob_controller.hpp"
+#include "local_server.hpp"
+#include "model/blob_resource.hpp"
+#include "model/verified_digest.hpp"
+#include "options.hpp"
+#include "utils/sha256.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr int64_t megabyte = 1024 * 1024;
+
+// random data, so nothing on the way can compress it
+std::string write_blob(const fs::path& directory, int64_t size_mb) {
+    const auto temp_path = directory / "blob.tmp";
+    {
+        std::ofstream stream(temp_path, std::ios::binary);
+        std::mt19937_64 random(size_mb);
+        std::vector<uint64_t> chunk(megabyte / sizeof(uint64_t));
+        for (int64_t i = 0; i < size_mb; ++i) {
+            for (auto& value : chunk) {
+                value = random();
+            }
+            stream.write(
+                reinterpret_cast<const char*>(chunk.data()),
+                megabyte
+            );
+        }
+        if (!stream) {
+            throw std::runtime_error("failed to write " + temp_path.string());
+        }
+    }
+    const auto digest = SHA256Hasher::hash_file(temp_path);
+    const auto path = directory / ("sha256_" + digest);
+    fs::rename(temp_path, path);
+    // only verified blobs are served
+    record_verified(path, digest);
+    return digest;
+}
+
+void run_pulls(
+    const MirrorConfig& mirror,
+    const std::string& digest,
+    const fs::path& directory,
+    const Options& options
+) {
+    const auto segment_mb = options.get_int("--segment-mb", 16);
+    for (const auto connections :
+         options.get_list("--connections", "1,2,4,8")) {
+        const auto target = directory / ("pull-" + std::to_string(connections));
+        fs::create_directories(target);
+        DownloadConfig config;
+        config.connections = static_cast<uint16_t>(connections);
+        config.segment_size_mb = static_cast<uint32_t>(segment_mb);
+        BlobResourceProvider provider(target, {mirror}, config);
+
+        const auto begin = std::chrono::steady_clock::now();
+        provider.pull_resource(digest, PullOptions {});
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - begin;
+        const auto seconds = elapsed.count();
+        const auto size = fs::file_size(provider.get_resource(digest));
+        std::printf(
+            "connections %3lld  %8.1f MB/s  (%.2f s for %.0f MB, including "
+            "the sha256 check)\n",
+            static_cast<long long>(connections),
+            static_cast<double>(size) / megabyte / seconds,
+            seconds,
+            static_cast<double>(size) / megabyte
+        );
+        fs::remove_all(target);
+    }
+}
+}  // namespace
+
+int download_benchmark(const std::vector<std::string>& arguments) {
+    const Options options(
+        arguments,
+        {"--size-mb", "--connections", "--segment-mb", "--mirror", "--digest"}
+    );
+    const auto directory = fs::temp_directory_path()
+        / ("hailo-ollama-bench-" + std::to_string(getpid()));
+    fs::create_directories(directory);
+
+    const auto remote = options.get("--mirror", "");
+    try {
+        if (!remote.empty()) {
+            // another hailo-ollama serving its blobs, over plain HTTP
+            const auto colon = remote.rfind(':');
+            const auto digest = options.get("--digest", "");
+            if (colon == std::string::npos || digest.empty()) {
+                throw std::invalid_argument(
+                    "--mirror takes host:port and needs --digest"
+                );
+            }
+            MirrorConfig mirror;
+            mirror.host = remote.substr(0, colon);
+            mirror.port =
+                static_cast<uint16_t>(std::stoi(remote.substr(colon + 1)));
+            mirror.tls = false;
+            mirror.peer = true;
+            run_pulls(mirror, digest, directory, options);
+        } else {
+            const auto source = directory / "source";
+            fs::create_directories(source);
+            const auto digest =
+                write_blob(source, options.get_int("--size-mb", 512));
+
+            uint16_t port = 0;
+            auto provider = listen_loopback(port);
+            MirrorConfig mirror;
+            mirror.host = "127.0.0.1";
+            mirror.port = port;
+            mirror.tls = false;
+            mirror.peer = true;
+            auto router = oatpp::web::server::HttpRouter::createShared();
+            router->addController(
+                std::make_shared<BlobController>(
+                    std::make_shared<BlobResourceProvider>(
+                        source,
+                        std::vector<MirrorConfig> {mirror}
+                    ),
+                    make_content_mappers()
+                )
+            );
+            const LocalServer server(
+                provider,
+                oatpp::web::server::HttpConnectionHandler::createShared(router)
+            );
+            // loopback has no latency, the gain of more connections shows
+            // against a distant --mirror
+            std::cout << "serving the blob on 127.0.0.1:" << port << "\n";
+            run_pulls(mirror, digest, directory, options);
+        }
+    } catch (...) {
+        fs::remove_all(directory);
+        throw;
+    }
+    fs::remove_all(directory);
+    return 0;
+}
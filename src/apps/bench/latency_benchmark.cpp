@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file latency_benchmark.cpp
+ * @brief Streamed token latency over the Unix socket and loopback TCP
+ **/
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "benchmarks.hpp"
+#include "client_socket.hpp"
+#include "options.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using json = nlohmann::json;
+
+// a model load may come first
+constexpr auto response_timeout = std::chrono::seconds(120);
+
+/**
+ * Reads a chunked HTTP response and calls back with the time every ndjson
+ * line arrived, which is one token of a streamed generation
+ */
+class TokenReader {
+  public:
+    using LineCallback =
+        std::function<void(const std::string&, Clock::time_point)>;
+
+    explicit TokenReader(const Socket& socket) : m_socket(socket) {}
+
+    void read(const LineCallback& on_line) {
+        const auto headers = read_until("\r\n\r\n");
+        if (headers.rfind("HTTP/1.1 200", 0) != 0) {
+            throw std::runtime_error(
+                "unexpected response: " + headers.substr(0, headers.find('\r'))
+            );
+        }
+        std::string line;
+        while (true) {
+            const auto size = std::stoul(read_until("\r\n"), nullptr, 16);
+            if (size == 0) {
+                return;
+            }
+            auto data = read_exactly(size);
+            const auto arrived = Clock::now();
+            (void)read_exactly(2);
+            for (const auto c : data) {
+                if (c != '\n') {
+                    line += c;
+                    continue;
+                }
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (!line.empty()) {
+                    on_line(line, arrived);
+                }
+                line.clear();
+            }
+        }
+    }
+
+  private:
+    void fill() {
+        char buffer[16 * 1024];
+        const auto count = recv(m_socket.get(), buffer, sizeof(buffer), 0);
+        if (count < 0) {
+            throw std::system_error(errno, std::generic_category(), "recv");
+        }
+        if (count == 0) {
+            throw std::runtime_error("the server closed the connection");
+        }
+        m_buffer.append(buffer, static_cast<size_t>(count));
+    }
+
+    // without the delimiter, which is consumed
+    std::string read_until(const std::string& delimiter) {
+        size_t end = 0;
+        while ((end = m_buffer.find(delimiter)) == std::string::npos) {
+            fill();
+        }
+        auto result = m_buffer.substr(0, end);
+        m_buffer.erase(0, end + delimiter.size());
+        return result;
+    }
+
+    std::string read_exactly(size_t size) {
+        while (m_buffer.size() < size) {
+            fill();
+        }
+        auto result = m_buffer.substr(0, size);
+        m_buffer.erase(0, size);
+        return result;
+    }
+
+  private:
+    const Socket& m_socket;
+    std::string m_buffer;
+};
+
+struct Samples {
+    // request sent until the first token
+    std::vector<double> first_token_ms;
+    // between consecutive tokens
+    std::vector<double> token_gap_us;
+};
+
+void generate(
+    const Socket& socket,
+    const std::string& body,
+    Samples& samples
+) {
+    socket.send_all(
+        "POST /api/generate HTTP/1.1\r\nHost: localhost\r\n"
+        "Content-Type: application/json\r\nContent-Length: "
+        + std::to_string(body.size()) + "\r\n\r\n" + body
+    );
+    const auto sent = Clock::now();
+    auto previous = sent;
+    bool first = true;
+    TokenReader(socket).read(
+        [&](const std::string& line, Clock::time_point arrived) {
+            if (json::parse(line).value("done", false)) {
+                return;
+            }
+            if (first) {
+                samples.first_token_ms.push_back(
+                    std::chrono::duration<double, std::milli>(arrived - sent)
+                        .count()
+                );
+                first = false;
+            } else {
+                samples.token_gap_us.push_back(
+                    std::chrono::duration<double, std::micro>(
+                        arrived - previous
+                    )
+                        .count()
+                );
+            }
+            previous = arrived;
+        }
+    );
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    const auto index = static_cast<size_t>(
+        fraction * static_cast<double>(values.size() - 1)
+    );
+    return values[index];
+}
+
+void print(const char* name, const Samples& samples) {
+    std::printf(
+        "%-5s  first token p50 %8.2f ms  token gap p50 %9.1f us  "
+        "p99 %9.1f us  (%zu tokens)\n",
+        name,
+        percentile(samples.first_token_ms, 0.5),
+        percentile(samples.token_gap_us, 0.5),
+        percentile(samples.token_gap_us, 0.99),
+        samples.token_gap_us.size()
+    );
+}
+}  // namespace
+
+int latency_benchmark(const std::vector<std::string>& arguments) {
+    const Options options(
+        arguments,
+        {"--tcp", "--unix", "--model", "--prompt", "--tokens", "--requests"}
+    );
+    const auto tcp = options.get("--tcp", "127.0.0.1:8000");
+    const auto colon = tcp.rfind(':');
+    const auto unix_path = options.get("--unix", "");
+    const auto model = options.get("--model", "");
+    if (unix_path.empty() || model.empty() || colon == std::string::npos) {
+        throw std::invalid_argument(
+            "--unix and --model are required, --tcp takes host:port"
+        );
+    }
+    const auto host = tcp.substr(0, colon);
+    const auto port = tcp.substr(colon + 1);
+    const auto requests = options.get_int("--requests", 10);
+    // greedy decoding with a fixed length: both transports carry the same
+    // tokens
+    const auto body = json {
+        {"model", model},
+        {"prompt", options.get("--prompt", "Count from one to one hundred.")},
+        {"stream", true},
+        {"options",
+         {{"temperature", 0},
+          {"seed", 1},
+          {"num_predict", options.get_int("--tokens", 128)}}},
+    }.dump();
+
+    // a first request loads the model, so it isn't measured
+    Samples warmup;
+    generate(connect_unix(unix_path, response_timeout), body, warmup);
+
+    Samples unix_samples;
+    Samples tcp_samples;
+    for (int64_t i = 0; i < requests; ++i) {
+        // alternating, so a drift of the device affects both the same way;
+        // every request on a new connection like most clients do
+        generate(
+            connect_unix(unix_path, response_timeout),
+            body,
+            unix_samples
+        );
+        generate(
+            connect_tcp(host, port, response_timeout),
+            body,
+            tcp_samples
+        );
+    }
+    print("unix", unix_samples);
+    print("tcp", tcp_samples);
+    return 0;
+}
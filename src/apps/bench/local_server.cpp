@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file local_server.cpp
+ * @brief LocalServer implementation
+ **/
+
+#include "local_server.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#include <oatpp/json/ObjectMapper.hpp>
+
+#include "network/tcp_connection_provider.hpp"
+
+LocalServer::LocalServer(
+    std::shared_ptr<oatpp::network::ServerConnectionProvider> provider,
+    std::shared_ptr<oatpp::network::ConnectionHandler> handler
+) :
+    m_provider(std::move(provider)),
+    m_handler(std::move(handler)),
+    m_server(m_provider, m_handler),
+    m_thread([this]() { m_server.run(); }) {}
+
+LocalServer::~LocalServer() {
+    m_provider->stop();
+    if (m_server.getStatus() == oatpp::network::Server::STATUS_RUNNING) {
+        m_server.stop();
+    }
+    m_handler->stop();
+    m_thread.join();
+}
+
+std::shared_ptr<oatpp::web::mime::ContentMappers> make_content_mappers() {
+    auto json = std::make_shared<oatpp::json::ObjectMapper>();
+    json->serializerConfig().json.includeNullElements = false;
+    auto mappers = std::make_shared<oatpp::web::mime::ContentMappers>();
+    mappers->putMapper(json);
+    mappers->setDefaultMapper(json);
+    return mappers;
+}
+
+std::shared_ptr<oatpp::network::ServerConnectionProvider>
+listen_loopback(uint16_t& port, const ListenOptions& options) {
+    const auto fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "socket");
+    }
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length)
+            != 0) {
+        const auto error = errno;
+        (void)close(fd);
+        throw std::system_error(error, std::generic_category(), "bind");
+    }
+    port = ntohs(address.sin_port);
+    return std::make_shared<TcpConnectionProvider>(
+        fd,
+        TcpListenOptions {},
+        options
+    );
+}
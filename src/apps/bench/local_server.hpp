@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file local_server.hpp
+ * @brief An HTTP server in the benchmark process
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <oatpp/network/ConnectionHandler.hpp>
+#include <oatpp/network/ConnectionProvider.hpp>
+#include <oatpp/network/Server.hpp>
+#include <oatpp/web/mime/ContentMappers.hpp>
+#include <oatpp/web/server/HttpRouter.hpp>
+
+#include "network/socket_connection_provider.hpp"
+
+/**
+ * Serves a router on a listener from a thread of its own until it is
+ * destroyed, the way the server does for each of its listeners
+ */
+class LocalServer {
+  public:
+    LocalServer(
+        std::shared_ptr<oatpp::network::ServerConnectionProvider> provider,
+        std::shared_ptr<oatpp::network::ConnectionHandler> handler
+    );
+    ~LocalServer();
+
+    LocalServer(const LocalServer&) = delete;
+    LocalServer& operator=(const LocalServer&) = delete;
+
+  private:
+    std::shared_ptr<oatpp::network::ServerConnectionProvider> m_provider;
+    std::shared_ptr<oatpp::network::ConnectionHandler> m_handler;
+    oatpp::network::Server m_server;
+    std::thread m_thread;
+};
+
+// JSON, like the server's
+std::shared_ptr<oatpp::web::mime::ContentMappers> make_content_mappers();
+
+// listens on 127.0.0.1 on a free port, which is returned in port
+std::shared_ptr<oatpp::network::ServerConnectionProvider>
+listen_loopback(uint16_t& port, const ListenOptions& options = {});
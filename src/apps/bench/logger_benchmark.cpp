@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file logger_benchmark.cpp
+ * @brief Latency of a log call while the log writer is stuck
+ **/
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "config/runtime_config.hpp"
+#include "logging/async_logger.hpp"
+#include "logging/log_policy.hpp"
+#include "options.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Points stdout at a pipe which is left unread for the stall, so the log
+ * writer blocks in write() once the pipe is full, and discarded after it.
+ * The destructor points stdout back.
+ */
+class StalledStdout {
+  public:
+    explicit StalledStdout(std::chrono::milliseconds stall) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw std::system_error(errno, std::generic_category(), "pipe");
+        }
+        std::fflush(stdout);
+        m_saved = dup(STDOUT_FILENO);
+        (void)dup2(fds[1], STDOUT_FILENO);
+        (void)close(fds[1]);
+        m_reader = std::thread([read_end = fds[0], stall]() {
+            std::this_thread::sleep_for(stall);
+            char buffer[64 * 1024];
+            while (read(read_end, buffer, sizeof(buffer)) > 0) {}
+            (void)close(read_end);
+        });
+    }
+
+    ~StalledStdout() {
+        std::fflush(stdout);
+        // closes the last write end, the reader sees the end of the pipe
+        (void)dup2(m_saved, STDOUT_FILENO);
+        (void)close(m_saved);
+        m_reader.join();
+    }
+
+    StalledStdout(const StalledStdout&) = delete;
+    StalledStdout& operator=(const StalledStdout&) = delete;
+
+  private:
+    int m_saved = -1;
+    std::thread m_reader;
+};
+
+double percentile(const std::vector<int64_t>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    return static_cast<double>(sorted[static_cast<size_t>(
+        fraction * static_cast<double>(sorted.size() - 1)
+    )]);
+}
+}  // namespace
+
+int logger_benchmark(const std::vector<std::string>& arguments) {
+    const Options options(
+        arguments,
+        {"--threads", "--messages", "--interval-us", "--stall-ms"}
+    );
+    const auto threads = options.get_int("--threads", 4);
+    const auto messages = options.get_int("--messages", 100000);
+    const auto interval =
+        std::chrono::microseconds(options.get_int("--interval-us", 10));
+    const auto stall =
+        std::chrono::milliseconds(options.get_int("--stall-ms", 3000));
+    if (threads < 1 || messages < 1) {
+        throw std::invalid_argument(
+            "--threads and --messages must be at least 1"
+        );
+    }
+    logging::configure(LogConfig());
+
+    // like the line of every completion request
+    const std::string tag = "handle_completion";
+    const std::string message = "Got model "
+        "/usr/share/hailo-ollama/models/blob/sha256_"
+        + std::string(64, 'f');
+    std::vector<std::vector<int64_t>> latencies(threads);
+    uint64_t dropped = 0;
+    Clock::duration elapsed {};
+    {
+        const StalledStdout stalled(stall);
+        std::optional<AsyncLogger> logger;
+        logger.emplace();
+        const auto begin = Clock::now();
+        std::vector<std::thread> workers;
+        for (int64_t i = 0; i < threads; ++i) {
+            workers.emplace_back([&, i]() {
+                auto& samples = latencies[i];
+                samples.reserve(messages);
+                for (int64_t j = 0; j < messages; ++j) {
+                    const auto start = Clock::now();
+                    logger->log(oatpp::Logger::PRIORITY_I, tag, message);
+                    samples.push_back(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start
+                        )
+                            .count()
+                    );
+                    std::this_thread::sleep_for(interval);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        elapsed = Clock::now() - begin;
+        dropped = logger->dropped();
+        // writes what is still queued, once the stall is over
+        logger.reset();
+    }
+
+    std::vector<int64_t> all;
+    for (const auto& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+    std::printf(
+        "%lld threads, %zu messages in %.2f s with stdout stalled for "
+        "%lld ms, %llu dropped\n",
+        static_cast<long long>(threads),
+        all.size(),
+        std::chrono::duration<double>(elapsed).count(),
+        static_cast<long long>(stall.count()),
+        static_cast<unsigned long long>(dropped)
+    );
+    std::printf(
+        "log() p50 %.0f ns  p99 %.0f ns  p99.9 %.0f ns  max %.0f ns\n",
+        percentile(all, 0.5),
+        percentile(all, 0.99),
+        percentile(all, 0.999),
+        static_cast<double>(all.back())
+    );
+    return 0;
+}
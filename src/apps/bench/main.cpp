@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file main.cpp
+ * @brief Hailo Ollama benchmarks
+ **/
+
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <oatpp/Environment.hpp>
+
+#include "benchmarks.hpp"
+
+namespace {
+using Benchmark = std::function<int(const std::vector<std::string>&)>;
+
+const std::map<std::string, Benchmark>& benchmarks() {
+    static const std::map<std::string, Benchmark> all {
+        {"connections", connections_benchmark},
+        {"download", download_benchmark},
+        {"latency", latency_benchmark},
+        {"logger", logger_benchmark},
+        {"sha256", sha256_benchmark},
+    };
+    return all;
+}
+
+void print_usage(const char* program) {
+    std::cerr
+        << "usage: " << program << " <benchmark> [--option value]...\n\n"
+        << "  connections  [--max-connections 16] [--connections 64]\n"
+        << "            more connections than the limit of a local server, or "
+           "of --server\n"
+        << "            host:port (threads counted with --pid), must get 503s "
+           "and no more threads\n"
+        << "  download  [--size-mb 512] [--connections 1,2,4,8] "
+           "[--segment-mb 16]\n"
+        << "            pull throughput from a local range server, or from "
+           "--mirror host:port\n"
+        << "            (a hailo-ollama peer) with --digest <hex>\n"
+        << "  latency   --unix path --model name [--tcp 127.0.0.1:8000] "
+           "[--tokens 128]\n"
+        << "            [--requests 10] [--prompt text]\n"
+        << "            streamed /api/generate token latency of a running "
+           "server, Unix socket\n"
+        << "            against TCP\n"
+        << "  logger    [--threads 4] [--messages 100000] [--interval-us 10] "
+           "[--stall-ms 3000]\n"
+        << "            log call latency while stdout isn't read, so the "
+           "writer blocks\n"
+        << "  sha256    [--size-mb 1024] [--file path] [--repeat 3]\n"
+        << "            hashing throughput of a file by read strategy, "
+           "cold and warm\n";
+}
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    if (argc < 2 || benchmarks().count(argv[1]) == 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    const std::vector<std::string> arguments(argv + 2, argv + argc);
+
+    oatpp::Environment::init();
+    auto result = 1;
+    try {
+        result = benchmarks().at(argv[1])(arguments);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        print_usage(argv[0]);
+        result = 2;
+    } catch (const std::exception& e) {
+        std::cerr << argv[1] << " failed: " << e.what() << "\n";
+    }
+    oatpp::Environment::destroy();
+    return result;
+}
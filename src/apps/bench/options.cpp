@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file options.cpp
+ * @brief Options implementation
+ **/
+
+#include "options.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utils/split.hpp"
+
+Options::Options(
+    const std::vector<std::string>& arguments,
+    std::initializer_list<const char*> known
+) {
+    for (size_t i = 0; i < arguments.size(); i += 2) {
+        const auto& name = arguments[i];
+        const auto is_known =
+            std::find(known.begin(), known.end(), name) != known.end();
+        if (!is_known || i + 1 >= arguments.size()) {
+            throw std::invalid_argument("unexpected argument " + name);
+        }
+        m_values[name] = arguments[i + 1];
+    }
+}
+
+std::string
+Options::get(const std::string& name, const std::string& fallback) const {
+    const auto it = m_values.find(name);
+    return it == m_values.end() ? fallback : it->second;
+}
+
+int64_t Options::get_int(const std::string& name, int64_t fallback) const {
+    const auto it = m_values.find(name);
+    return it == m_values.end() ? fallback : std::stoll(it->second);
+}
+
+std::vector<int64_t> Options::get_list(
+    const std::string& name,
+    const std::string& fallback
+) const {
+    const auto list = get(name, fallback);
+    std::vector<int64_t> values;
+    for (const auto value : SplitRange(list, ",")) {
+        values.push_back(std::stoll(std::string(value)));
+    }
+    return values;
+}
@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file options.hpp
+ * @brief Command line options of the benchmarks
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * "--name value" pairs; throws std::invalid_argument on anything else and on
+ * names the benchmark doesn't know
+ */
+class Options {
+  public:
+    Options(
+        const std::vector<std::string>& arguments,
+        std::initializer_list<const char*> known
+    );
+
+    std::string get(const std::string& name, const std::string& fallback)
+        const;
+    int64_t get_int(const std::string& name, int64_t fallback) const;
+    // "1,2,4"
+    std::vector<int64_t>
+    get_list(const std::string& name, const std::string& fallback) const;
+
+  private:
+    std::map<std::string, std::string> m_values;
+};
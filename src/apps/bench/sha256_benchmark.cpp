@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file sha256_benchmark.cpp
+ * @brief Blob hashing throughput by file read strategy
+ **/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "options.hpp"
+#include "utils/sha256.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr int64_t megabyte = 1024 * 1024;
+
+using FileRead = SHA256Hasher::FileRead;
+
+void write_file(const fs::path& path, int64_t size_mb) {
+    std::ofstream stream(path, std::ios::binary);
+    std::mt19937_64 random(size_mb);
+    std::vector<uint64_t> chunk(megabyte / sizeof(uint64_t));
+    for (int64_t i = 0; i < size_mb; ++i) {
+        for (auto& value : chunk) {
+            value = random();
+        }
+        stream.write(reinterpret_cast<const char*>(chunk.data()), megabyte);
+    }
+    if (!stream) {
+        throw std::runtime_error("failed to write " + path.string());
+    }
+}
+
+// drops the clean pages of the file, so the next read comes from the disk
+void evict_page_cache(const fs::path& path) {
+    const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        (void)fdatasync(fd);
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        (void)close(fd);
+    }
+}
+
+// the best of the repeats, in GB/s
+double measure(
+    const fs::path& path,
+    FileRead strategy,
+    bool cold,
+    int64_t repeat
+) {
+    const auto size = static_cast<double>(fs::file_size(path));
+    double best = 0;
+    for (int64_t i = 0; i < repeat; ++i) {
+        if (cold) {
+            evict_page_cache(path);
+        }
+        const auto begin = std::chrono::steady_clock::now();
+        SHA256Hasher hasher;
+        hasher.update_file(path, strategy);
+        (void)hasher.finalize();
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - begin;
+        best = std::max(best, size / 1e9 / elapsed.count());
+    }
+    return best;
+}
+}  // namespace
+
+int sha256_benchmark(const std::vector<std::string>& arguments) {
+    const Options options(arguments, {"--size-mb", "--file", "--repeat"});
+    const auto repeat = options.get_int("--repeat", 3);
+    if (repeat < 1) {
+        throw std::invalid_argument("--repeat must be at least 1");
+    }
+    auto path = fs::path(options.get("--file", ""));
+    const auto generated = path.empty();
+    if (generated) {
+        path = fs::temp_directory_path()
+            / ("hailo-ollama-bench-" + std::to_string(getpid()) + ".blob");
+        write_file(path, options.get_int("--size-mb", 1024));
+    }
+
+    const std::pair<const char*, FileRead> strategies[] = {
+        {"buffered", FileRead::BUFFERED},
+        {"double-buffered", FileRead::DOUBLE_BUFFERED},
+        {"mapped", FileRead::MAPPED},
+    };
+    std::printf(
+        "%.0f MB, sha256 instructions: %s\n",
+        static_cast<double>(fs::file_size(path)) / megabyte,
+        SHA256Hasher::hardware_accelerated() ? "yes" : "no"
+    );
+    try {
+        for (const auto& [name, strategy] : strategies) {
+            // cold reads need the page cache dropped, which fadvise only
+            // does for files this user may write back
+            const auto cold = measure(path, strategy, true, repeat);
+            const auto warm = measure(path, strategy, false, repeat);
+            std::printf(
+                "%-16s  cold %6.2f GB/s  warm %6.2f GB/s\n",
+                name,
+                cold,
+                warm
+            );
+        }
+    } catch (...) {
+        if (generated) {
+            fs::remove(path);
+        }
+        throw;
+    }
+    if (generated) {
+        fs::remove(path);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file main.cpp
+ * @brief Hailo Ollama command line tool
+ **/
+
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <oatpp/Environment.hpp>
+
+#include "model/importer.hpp"
+#include "utils/path.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+void print_usage(const char* program) {
+    std::cerr << "usage: " << program << " import <bundle> [--move]\n\n"
+              << "Imports the models of a bundle directory or tar archive "
+                 "laid out as\nmanifests/<model>/<tag>/manifest.json and "
+                 "blob/sha256_<digest>.\n"
+              << "  --move  move blobs out of a bundle directory instead of "
+                 "linking them\n";
+}
+
+int import(const fs::path& source, const ImportOptions& options) {
+    const auto model_directory = find_data_dir() / HAILO_MODELS;
+    const auto blob_directory = model_directory / HAILO_BLOB_DIR_NAME;
+    (void)fs::create_directories(blob_directory);
+    // no blob store: the quota and orphans are left to the server, which
+    // rescans the blobs once it sees the new manifests
+    ModelImporter importer(
+        blob_directory,
+        model_directory / HAILO_MODEL_MANIFEST,
+        nullptr
+    );
+    for (const auto& name : importer.import(source, options)) {
+        std::cout << name << "\n";
+    }
+    return 0;
+}
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    if (argc < 3 || std::string_view(argv[1]) != "import") {
+        print_usage(argv[0]);
+        return 2;
+    }
+    ImportOptions options;
+    for (int i = 3; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--move") {
+            options.move = true;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    oatpp::Environment::init();
+    auto result = 1;
+    try {
+        result = import(argv[2], options);
+    } catch (const std::exception& e) {
+        std::cerr << "import failed: " << e.what() << "\n";
+    }
+    oatpp::Environment::destroy();
+    return result;
+}
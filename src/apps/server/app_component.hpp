@@ -9,14 +9,27 @@
 
 #pragma once
 
-#include <cstdint>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <oatpp/json/ObjectMapper.hpp>
 #include <oatpp/macro/component.hpp>
-#include <oatpp/network/tcp/server/ConnectionProvider.hpp>
 #include <oatpp/web/mime/ContentMappers.hpp>
 #include <oatpp/web/server/HttpConnectionHandler.hpp>
 
+#include "config/runtime_config.hpp"
+#include "network/server_connection.hpp"
+#include "network/socket_activation.hpp"
+#include "network/socket_connection_provider.hpp"
+#include "network/tcp_connection_provider.hpp"
+#include "network/unix_connection_provider.hpp"
+
 /**
  *  Class which creates and holds Application components and registers
  * components in oatpp::base::Environment Order of components initialization is
@@ -24,19 +37,94 @@
  */
 class AppComponent {
   public:
-    AppComponent(const std::string& host, uint16_t port) :
-        serverConnectionProvider(
-            oatpp::network::tcp::server::ConnectionProvider::createShared(
-                {host, port, oatpp::network::Address::IP_4}
-            )
-        ) {}
+    // a connection provider and the address it listens on, for logging
+    struct Listener {
+        std::shared_ptr<oatpp::network::ServerConnectionProvider> provider;
+        std::string address;
+    };
+
+    explicit AppComponent(const ServerConfig& config) :
+        connectionLimiter(
+            std::make_shared<ConnectionLimiter>(config.max_connections)
+        ),
+        sharedSockets(false) {
+        ListenOptions options;
+        options.backlog = config.backlog;
+        options.idle_timeout = std::chrono::seconds(config.idle_timeout_s);
+        options.limiter = connectionLimiter;
+        const auto activated = activated_sockets();
+        for (const auto fd : activated) {
+            // systemd owns the sockets, the configured ones aren't used
+            std::shared_ptr<oatpp::network::ServerConnectionProvider> provider;
+            if (socket_family(fd) == AF_UNIX) {
+                provider = std::make_shared<UnixSocketConnectionProvider>(
+                    fd,
+                    options
+                );
+            } else {
+                TcpListenOptions tcp_options;
+                tcp_options.no_delay = config.tcp_nodelay;
+                provider = std::make_shared<TcpConnectionProvider>(
+                    fd,
+                    tcp_options,
+                    options
+                );
+            }
+            serverConnectionProviders.push_back(
+                {provider, "fd " + std::to_string(fd) + " from systemd"}
+            );
+        }
+        sharedSockets = !activated.empty() || config.reuse_port;
+        if (config.tcp && activated.empty()) {
+            TcpListenOptions tcp_options;
+            tcp_options.no_delay = config.tcp_nodelay;
+            tcp_options.reuse_port = config.reuse_port;
+            serverConnectionProviders.push_back(
+                {TcpConnectionProvider::createShared(
+                     config.host,
+                     config.port,
+                     tcp_options,
+                     options
+                 ),
+                 config.host + ":" + std::to_string(config.port)}
+            );
+        }
+        if (!config.unix_socket.empty() && activated.empty()) {
+            serverConnectionProviders.push_back(
+                {UnixSocketConnectionProvider::createShared(
+                     config.unix_socket,
+                     static_cast<mode_t>(
+                         std::stoul(config.unix_socket_mode, nullptr, 8)
+                     ),
+                     options
+                 ),
+                 "unix:" + config.unix_socket}
+            );
+        }
+        if (serverConnectionProviders.empty()) {
+            throw std::invalid_argument(
+                "server: neither tcp nor unix_socket is enabled"
+            );
+        }
+    }
 
     /**
-   *  Create ConnectionProvider component which listens on the port
+   *  Open connections of all listeners
    */
-    oatpp::Environment::Component<
-        std::shared_ptr<oatpp::network::ServerConnectionProvider>>
-        serverConnectionProvider;
+    std::shared_ptr<ConnectionLimiter> connectionLimiter;
+
+    /**
+   *  ConnectionProviders which listen on the TCP port and the Unix socket,
+   * each one is run by its own server
+   */
+    std::vector<Listener> serverConnectionProviders;
+
+    /**
+   *  Another process may accept on the same sockets, which should get the new
+   * connections while this one drains
+   */
+    bool sharedSockets;
+
     /**
    *  Create Router component
    */
@@ -7,109 +7,236 @@
  * @brief Hailo Ollama server main
  **/
 
+#include <chrono>
 #include <csignal>
 #include <cstdint>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
 #include <thread>
+#include <vector>
 
 #include <hailo/genai/llm/llm.hpp>
 #include <oatpp/macro/component.hpp>
 #include <oatpp/network/Server.hpp>
+#include <oatpp/web/server/HttpConnectionHandler.hpp>
 
 #include "app_component.hpp"
 #include "config/runtime_config.hpp"
+#include "controller/blob_controller.hpp"
 #include "controller/controller.hpp"
+#include "controller/drain_gate.hpp"
+#include "controller/metrics_controller.hpp"
+#include "controller/pull_registry.hpp"
+#include "controller/trace_controller.hpp"
 #include "generation_context/deconfigure.hpp"
 #include "generation_context/generation_context.hpp"
+#include "generation_context/prefetcher.hpp"
+#include "logging/async_logger.hpp"
+#include "logging/log_policy.hpp"
+#include "metrics/request_interceptor.hpp"
+#include "metrics/server_metrics.hpp"
 #include "model/blob_resource.hpp"
+#include "model/blob_store.hpp"
+#include "model/catalog_prefetcher.hpp"
+#include "model/importer.hpp"
 #include "model/simple_store.hpp"
+#include "model/watching_store.hpp"
+#include "tracing/trace_interceptor.hpp"
+#include "tracing/tracer.hpp"
 #include "utils/path.hpp"
-#include "utils/split.hpp"
-
-namespace {
-volatile std::sig_atomic_t global_signal_status;
-std::atomic<bool> global_shutdown_requested_flag = false;
-// must guarantee that we can safely use global_shutdown_requested_flag in signal handler
-static_assert(std::atomic<bool>::is_always_lock_free);
-}  // namespace
-
-// signal handler - can't do anything but use our safe global flags
-void signal_handler(int signal) {
-    global_signal_status = signal;
-    global_shutdown_requested_flag = true;
-}
+#include "utils/sha256.hpp"
+#include "utils/signal_waiter.hpp"
 
 namespace fs = std::filesystem;
 using json = nlohmann::ordered_json;
 
-fs::path
-find_dir(const fs::path& user_dir, const std::string& additional_dirs) {
-    std::vector<fs::path> options = {
-        user_dir,
-    };
-
-    for (const auto& path : SplitRange(additional_dirs, ":")) {
-        options.push_back(fs::path(path));
-    }
+namespace {
+// applies the parts of a reloaded configuration which can change at runtime
+using ReloadHook = std::function<void(const RuntimeConfig&)>;
 
-    for (const auto& option : options) {
-        auto dir_path = option / HAILO_DIR_NAME;
-        const auto is_dir = fs::is_directory(fs::status(dir_path));
-        if (is_dir) {
-            return dir_path;
-        }
-    }
-    throw std::runtime_error("hailo-ollama directory not found");
+RuntimeConfig load_config(const fs::path& config_file_path) {
+    std::ifstream config_stream(config_file_path);
+    const auto config_json = json::parse(config_stream);
+    return config_json.template get<RuntimeConfig>();
 }
 
-fs::path find_config_dir() {
-    return find_dir(config_home(), system_config_home());
+void reload_config(
+    const fs::path& config_file_path,
+    const std::vector<ReloadHook>& hooks
+) {
+    RuntimeConfig config;
+    try {
+        config = load_config(config_file_path);
+    } catch (const std::exception& e) {
+        OATPP_LOGe(
+            "MyApp",
+            "config reload failed, keeping the old one: {}",
+            e.what()
+        );
+        return;
+    }
+    for (const auto& hook : hooks) {
+        hook(config);
+    }
+    OATPP_LOGi(
+        "MyApp",
+        "config reloaded from {}, other changes apply after a restart",
+        config_file_path.string()
+    );
 }
 
-fs::path find_data_dir() {
-    return find_dir(data_home(), system_data_home());
+// writes the buffered spans next to the manifest index
+void dump_trace() {
+    const auto directory = cache_home() / HAILO_DIR_NAME;
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    );
+    const auto path =
+        directory / ("trace-" + std::to_string(seconds.count()) + ".json");
+    std::error_code error_code;
+    fs::create_directories(directory, error_code);
+    std::ofstream stream(path);
+    stream << tracing::Tracer::instance().chrome_trace();
+    if (!stream) {
+        OATPP_LOGe("MyApp", "failed to write trace to {}", path.string());
+        return;
+    }
+    OATPP_LOGi("MyApp", "trace written to {}", path.string());
 }
+}  // namespace
 
 void run() {
+    const auto startup_begin = std::chrono::steady_clock::now();
+    // before any thread is started, so all of them inherit the signal mask
+    SignalWaiter signals({SIGINT, SIGTERM, SIGHUP, SIGUSR1});
+    // request threads only queue their messages, the writer thread does I/O
+    const auto logger = std::make_shared<AsyncLogger>();
+    oatpp::Environment::setLogger(logger);
     const auto config_file_path = find_config_dir() / HAILO_CONFIG_NAME;
-    std::ifstream config_stream(config_file_path);
-    const auto config_json = json::parse(config_stream);
-    const auto config = config_json.template get<RuntimeConfig>();
+    const auto config = load_config(config_file_path);
+    logging::configure(config.log);
+    tracing::Tracer::set_enabled(config.tracing);
 
     /* Register Components in scope of run() method */
-    AppComponent components(config.server.host, config.server.port);
+    AppComponent components(config.server);
 
     /* Get router component */
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
 
-    auto generation_context = std::make_shared<SyncGenerationContext>();
+    const auto metrics =
+        config.metrics ? std::make_shared<ServerMetrics>() : nullptr;
+    const auto prefetcher =
+        config.prefetch_hef ? std::make_shared<HefPrefetcher>() : nullptr;
+    /* Create MyController and add all of its endpoints to router */
+    const auto model_directory = find_data_dir() / HAILO_MODELS;
+    const auto manifest_directory = model_directory / HAILO_MODEL_MANIFEST;
+    const auto manifest_index =
+        cache_home() / HAILO_DIR_NAME / HAILO_MANIFEST_INDEX;
+    std::shared_ptr<ModelStore> model_store;
+    std::shared_ptr<WatchingModelStore> watching_store;
+    if (config.watch_manifests) {
+        watching_store = std::make_shared<WatchingModelStore>(
+            manifest_directory,
+            manifest_index
+        );
+        model_store = watching_store;
+    } else {
+        model_store = std::make_shared<SimpleModelStore>(
+            manifest_directory,
+            manifest_index
+        );
+    }
+    const auto blob_directory = model_directory / HAILO_BLOB_DIR_NAME;
+    (void)fs::create_directory(blob_directory);
+    auto mirrors = config.mirrors;
+    if (mirrors.empty()) {
+        mirrors.push_back({config.library.host, config.library.port});
+    }
+    auto blob_store = std::make_shared<BlobStore>(
+        blob_directory,
+        config.blob_store.quota_mb * 1024 * 1024,
+        [model_store]() {
+            BlobStore::DigestSet referenced;
+            for (const auto& name : model_store->get_model_names()) {
+                const auto summary = model_store->get_model_summary(name);
+                if (summary) {
+                    referenced.insert(summary->hef_resource);
+                }
+            }
+            return referenced;
+        }
+    );
+    blob_store->collect_garbage(config.blob_store.remove_orphans);
+    if (watching_store) {
+        // manifests come after their blobs, e.g. from the command line tool;
+        // weak since the blob store holds the model store
+        watching_store->set_listener(
+            [weak_store = std::weak_ptr<BlobStore>(blob_store)]() {
+                if (const auto store = weak_store.lock()) {
+                    store->rescan();
+                }
+            }
+        );
+    }
+    auto generation_context = std::make_shared<SyncGenerationContext>(
+        prefetcher,
+        metrics,
+        blob_store
+    );
     Deconfigure deconfigure_loop(generation_context);
     std::thread deconfigure_thread(
         &Deconfigure::deconfigure_loop,
         &deconfigure_loop
     );
-
-    /* Create MyController and add all of its endpoints to router */
-    const auto model_directory = find_data_dir() / HAILO_MODELS;
-    auto model_store = std::make_shared<SimpleModelStore>(
-        model_directory / HAILO_MODEL_MANIFEST
-    );
-    const auto blob_directory = model_directory / HAILO_BLOB_DIR_NAME;
-    (void)fs::create_directory(blob_directory);
     auto resource_provider = std::make_shared<BlobResourceProvider>(
         blob_directory,
-        config.library.host,
-        config.library.port
+        mirrors,
+        config.download,
+        blob_store,
+        metrics
     );
+    auto importer = std::make_shared<ModelImporter>(
+        blob_directory,
+        manifest_directory,
+        blob_store
+    );
+    const auto drain_gate = std::make_shared<DrainGate>();
+    const auto pulls = std::make_shared<PullRegistry>();
+    std::unique_ptr<CatalogPrefetcher> catalog_prefetcher;
+    if (config.prefetch.all || !config.prefetch.models.empty()) {
+        catalog_prefetcher = std::make_unique<CatalogPrefetcher>(
+            config.prefetch,
+            model_store,
+            resource_provider,
+            // paused while generations or loads are admitted; probing the
+            // device lock instead would make a request find it taken
+            [drain_gate]() { return drain_gate->active() > 0; }
+        );
+    }
     router->addController(
         std::make_shared<MyController>(
             generation_context,
             model_store,
-            resource_provider
+            resource_provider,
+            blob_store,
+            importer,
+            prefetcher,
+            drain_gate,
+            pulls,
+            metrics
         )
     );
+    if (config.serve_blobs) {
+        router->addController(
+            std::make_shared<BlobController>(resource_provider)
+        );
+    }
 
     /* Get connection handler component */
     OATPP_COMPONENT(
@@ -117,62 +244,202 @@ void run() {
         connectionHandler
     );
 
-    /* Get connection provider component */
-    OATPP_COMPONENT(
-        std::shared_ptr<oatpp::network::ServerConnectionProvider>,
-        connectionProvider
-    );
+    // the component is created as an HttpConnectionHandler
+    const auto http_handler =
+        std::static_pointer_cast<oatpp::web::server::HttpConnectionHandler>(
+            connectionHandler
+        );
+#ifdef HAILO_TRACING
+    router->addController(std::make_shared<TraceController>());
+    const auto trace_interceptor = std::make_shared<TraceInterceptor>();
+    http_handler->addRequestInterceptor(trace_interceptor);
+    http_handler->addResponseInterceptor(trace_interceptor);
+#endif
+    if (metrics) {
+        router->addController(std::make_shared<MetricsController>(metrics));
+        const auto interceptor =
+            std::make_shared<RequestMetricsInterceptor>(metrics, router);
+        http_handler->addRequestInterceptor(interceptor);
+        http_handler->addResponseInterceptor(interceptor);
+
+        auto& registry = metrics->registry();
+        registry.gauge(
+            "hailo_connections_active",
+            "Open client connections of all listeners",
+            [limiter = components.connectionLimiter]() {
+                return static_cast<double>(limiter->active());
+            }
+        );
+        registry.gauge(
+            "hailo_generations_active",
+            "Generations and model loads in progress or waiting for the device",
+            [drain_gate]() { return static_cast<double>(drain_gate->active()); }
+        );
+        registry.gauge(
+            "hailo_blob_store_used_bytes",
+            "Disk space used by verified blobs",
+            [blob_store]() {
+                return static_cast<double>(blob_store->usage().used_bytes);
+            }
+        );
+    }
 
-    /* Create server which takes provided TCP connections and passes them to HTTP
-   * connection handler */
-    oatpp::network::Server server(connectionProvider, connectionHandler);
+    /* Create a server for each listener, all of them take the provided
+   * connections to the same HTTP connection handler */
+    std::vector<std::unique_ptr<oatpp::network::Server>> servers;
+    for (const auto& listener : components.serverConnectionProviders) {
+        servers.push_back(
+            std::make_unique<oatpp::network::Server>(
+                listener.provider,
+                connectionHandler
+            )
+        );
+        OATPP_LOGi("MyApp", "Server listening on {}", listener.address);
+    }
 
-    /* Print info about server port */
     OATPP_LOGi(
         "MyApp",
-        "Server running on port {}",
-        connectionProvider->getProperty("port").toString()
+        "Server running, startup took {} ms",
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startup_begin
+        )
+            .count()
+    );
+    OATPP_LOGi(
+        "MyApp",
+        "SHA-256 hardware acceleration {}",
+        SHA256Hasher::hardware_accelerated() ? "available" : "not available"
     );
 
+    std::vector<ReloadHook> reload_hooks;
+    reload_hooks.push_back([blob_store](const RuntimeConfig& reloaded) {
+        blob_store->set_quota(reloaded.blob_store.quota_mb * 1024 * 1024);
+    });
+    reload_hooks.push_back([](const RuntimeConfig& reloaded) {
+        tracing::Tracer::set_enabled(reloaded.tracing);
+    });
+    reload_hooks.push_back([](const RuntimeConfig& reloaded) {
+        try {
+            logging::configure(reloaded.log);
+        } catch (const std::invalid_argument& e) {
+            OATPP_LOGe("MyApp", "keeping the log levels: {}", e.what());
+        }
+    });
+
     /* Run server */
-    (void)std::signal(SIGINT, signal_handler);
-    (void)std::signal(SIGTERM, signal_handler);
-    std::thread server_thread([&server] { server.run(); });
-    while (!global_shutdown_requested_flag) {
-        // wait for signal. We want sigwait here but it's platform-specific
-        std::this_thread::sleep_for(
-            std::chrono::milliseconds(config.main_poll_time_ms)
-        );
+    std::vector<std::thread> server_threads;
+    for (auto& server : servers) {
+        server_threads.emplace_back([&server, &signals] {
+            try {
+                server->run();
+            } catch (const std::exception& e) {
+                OATPP_LOGe("MyApp", "server stopped: {}", e.what());
+            }
+            // a listener which died takes the others down with it
+            signals.notify();
+        });
+    }
+    // sleeps until a signal or a request from another thread arrives
+    while (true) {
+        const auto signal = signals.wait();
+        if (signal == SIGUSR1) {
+            dump_trace();
+            continue;
+        }
+        if (signal != SIGHUP) {
+            break;
+        }
+        reload_config(config_file_path, reload_hooks);
     }
     OATPP_LOGi(
         "MyApp",
         "Stop signal received, please wait for server shutdown"
     );
-    // reinstall the default handler - allow user to kill immediately with extra CTRL+C
-    (void)std::signal(SIGINT, SIG_DFL);
+    // allow user to kill immediately with extra CTRL+C
+    signals.restore(SIGINT);
 
-    /* First, stop the ServerConnectionProvider so we don't accept any new connections */
-    connectionProvider->stop();
+    /* Drain - new generations and pulls get 503, the running ones finish */
+    drain_gate->drain();
+    if (components.sharedSockets) {
+        // the process taking over accepts the new connections meanwhile
+        for (const auto& listener : components.serverConnectionProviders) {
+            listener.provider->stop();
+        }
+    }
+    const auto drain_timeout =
+        std::chrono::seconds(config.server.drain_timeout_s);
+    if (drain_gate->active() > 0) {
+        OATPP_LOGi(
+            "MyApp",
+            "waiting up to {} s for {} running generations",
+            drain_timeout.count(),
+            drain_gate->active()
+        );
+    }
+    if (pulls->active() > 0) {
+        OATPP_LOGi(
+            "MyApp",
+            "waiting up to {} s for {} running pulls",
+            drain_timeout.count(),
+            pulls->active()
+        );
+    }
+    const auto drain_deadline =
+        std::chrono::steady_clock::now() + drain_timeout;
+    if (!drain_gate->wait_idle(drain_deadline)) {
+        OATPP_LOGw(
+            "MyApp",
+            "drain timed out, cutting {} generations",
+            drain_gate->active()
+        );
+    }
+    if (!pulls->wait_idle(drain_deadline)) {
+        OATPP_LOGw(
+            "MyApp",
+            "drain timed out, cancelling {} pulls",
+            pulls->active()
+        );
+    }
+
+    /* First, stop the ServerConnectionProviders so we don't accept any new connections */
+    for (const auto& listener : components.serverConnectionProviders) {
+        listener.provider->stop();
+    }
 
-    /* Now, check if server is still running and stop it if needed */
-    if (server.getStatus() == oatpp::network::Server::STATUS_RUNNING) {
-        server.stop();
+    /* Now, check if the servers are still running and stop them if needed */
+    for (auto& server : servers) {
+        if (server->getStatus() == oatpp::network::Server::STATUS_RUNNING) {
+            server->stop();
+        }
     }
 
+    // cancel the background pulls before the generation context goes away,
+    // then the ones of clients - a client pull may wait for a background one
+    catalog_prefetcher.reset();
+    pulls->stop();
+
     /* Finally, stop the ConnectionHandler and wait until all running connections are closed */
     connectionHandler->stop();
 
     // Stop the deconfigure thread
     generation_context->lock()->stop();
 
-    /* Before returning, check if the server-thread has already stopped or if we need to wait for the server to stop */
-    if (server_thread.joinable()) {
-        /* We need to wait until the thread is done */
-        server_thread.join();
+    /* Before returning, check if the server threads have already stopped or if we need to wait for the servers to stop */
+    for (auto& server_thread : server_threads) {
+        if (server_thread.joinable()) {
+            /* We need to wait until the thread is done */
+            server_thread.join();
+        }
     }
     if (deconfigure_thread.joinable()) {
         deconfigure_thread.join();
     }
+    if (logger->dropped() > 0) {
+        OATPP_LOGw("MyApp", "{} log messages were dropped", logger->dropped());
+    }
+    // back to synchronous logging, the queued messages are written once the
+    // last reference to the logger is gone
+    oatpp::Environment::setLogger(std::make_shared<oatpp::DefaultLogger>());
 }
 
 /**
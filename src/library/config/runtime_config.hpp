@@ -10,24 +10,178 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
 #include <string>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
+// Fields missing from the configuration file keep the defaults below
+
 struct ConnectionDetails {
     std::string host;
-    uint16_t port;
+    // also when only the host is configured
+    uint16_t port = 443;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ConnectionDetails, host, port)
+
+struct ServerConfig {
+    std::string host = "0.0.0.0";
+    uint16_t port = 8000;
+    // listen on host and port
+    bool tcp = true;
+    // also, or only, listen on this Unix domain socket when not empty
+    std::string unix_socket;
+    // octal permissions of the socket file
+    std::string unix_socket_mode = "0660";
+    // each connection is served by its own thread -> bounds the threads too;
+    // connections above it get 503, 0 means unlimited
+    uint32_t max_connections = 64;
+    int32_t backlog = 128;
+    // send streamed tokens right away instead of coalescing them
+    bool tcp_nodelay = true;
+    // close connections which don't send a request for this long, 0 never
+    uint32_t idle_timeout_s = 60;
+    // let several processes listen on the same port
+    bool reuse_port = false;
+    // running generations get this long to finish at shutdown, 0 cuts them
+    uint32_t drain_timeout_s = 30;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+    ServerConfig,
+    host,
+    port,
+    tcp,
+    unix_socket,
+    unix_socket_mode,
+    max_connections,
+    backlog,
+    tcp_nodelay,
+    idle_timeout_s,
+    reuse_port,
+    drain_timeout_s
+)
+
+struct MirrorConfig {
+    std::string host;
+    uint16_t port = 443;
+    // plain HTTP is meant for caches on the local network
+    bool tls = true;
+    // preferred over mirrors with a lower weight and the same latency
+    uint32_t weight = 1;
+    // another hailo-ollama node, serving its blobs under /hailo/v1/blob
+    bool peer = false;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+    MirrorConfig,
+    host,
+    port,
+    tls,
+    weight,
+    peer
+)
+
+struct DownloadConfig {
+    // parallel range requests per blob, 1 downloads over a single stream;
+    // a segmented blob is read once more to hash it, the stream is hashed
+    // while it's written
+    uint16_t connections = 1;
+    uint32_t segment_size_mb = 16;
+    // write blobs with O_DIRECT, bypassing the page cache
+    bool direct_io = false;
+    // a mirror slower than this over the timeout is switched for the next
+    uint32_t stall_timeout_s = 30;
+    uint32_t stall_min_rate_kbps = 32;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ConnectionDetails, host, port)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+    DownloadConfig,
+    connections,
+    segment_size_mb,
+    direct_io,
+    stall_timeout_s,
+    stall_min_rate_kbps
+)
+
+struct BlobStoreConfig {
+    // least recently used blobs are removed above it, 0 means unlimited
+    uint64_t quota_mb = 0;
+    // remove blobs which no manifest references at startup
+    bool remove_orphans = true;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+    BlobStoreConfig,
+    quota_mb,
+    remove_orphans
+)
+
+struct PrefetchConfig {
+    // pulled in the background at startup
+    std::vector<std::string> models;
+    // every model in the catalog instead of the list
+    bool all = false;
+    // total rate of the background downloads, 0 means unlimited
+    uint32_t max_rate_kbps = 0;
+    // hold the downloads while a model is loaded or generating
+    bool pause_while_generating = true;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+    PrefetchConfig,
+    models,
+    all,
+    max_rate_kbps,
+    pause_while_generating
+)
+
+struct LogConfig {
+    // error, warning, info, debug or verbose
+    std::string level = "info";
+    // levels by log tag, e.g. {"model_store": "warning"}
+    std::map<std::string, std::string> tags;
+    // bytes of a prompt which are logged, 0 logs only its length
+    uint32_t prompt_bytes = 128;
+    // one in this many messages of a frequent event is logged
+    uint32_t sample_every = 100;
+};
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
+    LogConfig,
+    level,
+    tags,
+    prompt_bytes,
+    sample_every
+)
 
 struct RuntimeConfig {
-    ConnectionDetails server;
-    ConnectionDetails library;
-    uint16_t main_poll_time_ms;
+    ServerConfig server;
+    ConnectionDetails library {"dev-public.hailo.ai"};
+    // replace library when not empty
+    std::vector<MirrorConfig> mirrors;
+    DownloadConfig download;
+    BlobStoreConfig blob_store;
+    PrefetchConfig prefetch;
+    // reload manifests when they change on disk
+    bool watch_manifests = true;
+    // let other nodes use this one as a mirror
+    bool serve_blobs = true;
+    // read the HEF into the page cache while a request waits for the device
+    bool prefetch_hef = true;
+    // Prometheus metrics on /metrics
+    bool metrics = true;
+    // record spans of the request path, if compiled in
+    bool tracing = false;
+    LogConfig log;
 };
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(
     RuntimeConfig,
     server,
     library,
-    main_poll_time_ms
+    mirrors,
+    download,
+    blob_store,
+    prefetch,
+    watch_manifests,
+    serve_blobs,
+    prefetch_hef,
+    metrics,
+    tracing,
+    log
 )
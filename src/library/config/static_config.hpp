@@ -14,9 +14,53 @@
 
 namespace config {
 constexpr size_t hash_buffer_size = 4 * 1024 * 1024;  // 4 MB
-constexpr int_fast32_t output_file_stream_update_every = 1000;
+// pull progress is sent when either limit is reached
+constexpr auto pull_progress_interval = std::chrono::milliseconds(100);
+constexpr int64_t pull_progress_bytes = 1024 * 1024;  // 1 MB
+// the last progress is repeated when nothing changed for this long
+constexpr auto pull_progress_heartbeat = std::chrono::seconds(5);
+// interrupted downloads are resumed from the partial file
+constexpr int download_max_attempts = 5;
+constexpr auto download_retry_delay = std::chrono::seconds(2);
+// a paused background download checks this often whether it may continue
+constexpr auto download_pause_poll = std::chrono::milliseconds(500);
+// keep-alive connections to the library, shared by all pulls
+constexpr int64_t download_pool_max_connections = 16;
+constexpr auto download_pool_idle_ttl = std::chrono::seconds(30);
+// a library host which doesn't answer the connect is failed over
+constexpr auto download_connect_timeout = std::chrono::seconds(10);
+// mirrors are ranked by the latency of a one byte range request
+constexpr auto mirror_probe_timeout = std::chrono::seconds(3);
+constexpr auto mirror_ranking_ttl = std::chrono::minutes(1);
+// older partial downloads are removed at startup instead of being resumed
+constexpr auto blob_stale_partial_age = std::chrono::hours(24);
+// HEFs are read into the page cache in chunks while a request waits
+constexpr int64_t prefetch_chunk = 8 * 1024 * 1024;  // 8 MB
+// a HEF isn't read again if it was prefetched within this interval
+constexpr auto prefetch_repeat_interval = std::chrono::minutes(5);
+// nice value of the thread pulling catalog models in the background
+constexpr int catalog_prefetch_nice = 10;
+// dead connections are dropped by TCP keep-alive
+constexpr int download_keepalive_idle_s = 10;
+constexpr int download_keepalive_interval_s = 5;
+constexpr int download_keepalive_count = 3;
+// blobs are written to disk in blocks of this size
+constexpr size_t blob_write_buffer_size = 4 * 1024 * 1024;  // 4 MB
+constexpr int64_t blob_write_alignment = 4096;
+// blobs served to peers are read in chunks of this size per connection
+constexpr size_t blob_serve_buffer_size = 256 * 1024;  // 256 KB
 constexpr auto generation_context_device_switch_sleep_time =
     std::chrono::seconds(2);
 constexpr auto controller_default_keep_alive = std::chrono::minutes(5);
 constexpr auto controller_show_parameter_width = 30;
+// a streamed chunk which takes longer to write counts as a stall
+constexpr auto metrics_stream_stall_threshold = std::chrono::milliseconds(100);
+// spans kept for the trace dump, the oldest ones are overwritten
+constexpr size_t trace_buffer_spans = 32768;
+// log messages waiting for the writer, more are dropped, a power of two
+constexpr size_t log_queue_capacity = 4096;
+// the log writer wakes up at least this often
+constexpr auto log_flush_interval = std::chrono::milliseconds(50);
+// background parsing of manifests which were loaded from the index
+constexpr size_t manifest_warmup_threads = 2;
 }  // namespace config
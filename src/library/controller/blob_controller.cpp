@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file blob_controller.cpp
+ * @brief BlobController implementation
+ **/
+
+#include "controller/blob_controller.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <oatpp/web/server/api/ApiController.hpp>
+
+#include "controller/file_range_body.hpp"
+#include "model/resource.hpp"
+#include "model/verified_digest.hpp"
+
+namespace {
+using OutgoingResponse = oatpp::web::protocol::http::outgoing::Response;
+using Status = oatpp::web::protocol::http::Status;
+
+constexpr size_t sha256_hex_length = 64;
+
+// "sha256_<hex>" as requested by the download client, or "sha256:<hex>"
+std::optional<std::string> parse_digest(const std::string& digest) {
+    std::string hex;
+    for (const auto* prefix : {"sha256_", "sha256:"}) {
+        if (digest.rfind(prefix, 0) == 0) {
+            hex = digest.substr(std::string(prefix).size());
+        }
+    }
+    // the digest becomes part of a path
+    if (hex.size() != sha256_hex_length
+        || hex.find_first_not_of("0123456789abcdef") != std::string::npos) {
+        return std::nullopt;
+    }
+    return hex;
+}
+
+struct ByteRange {
+    int64_t begin;
+    int64_t end;  // exclusive
+};
+
+// a single "bytes=" range; std::nullopt if it can't be satisfied
+std::optional<ByteRange> parse_range(const std::string& value, int64_t size) {
+    constexpr std::string_view prefix = "bytes=";
+    if (value.compare(0, prefix.size(), prefix) != 0) {
+        return std::nullopt;
+    }
+    const auto spec = value.substr(prefix.size());
+    const auto dash = spec.find('-');
+    if (dash == std::string::npos || spec.find(',') != std::string::npos) {
+        return std::nullopt;
+    }
+    try {
+        const auto first = spec.substr(0, dash);
+        const auto last = spec.substr(dash + 1);
+        if (first.empty()) {
+            // "-n" is the last n bytes
+            const auto suffix = std::stoll(last);
+            if (suffix <= 0) {
+                return std::nullopt;
+            }
+            return ByteRange {std::max<int64_t>(size - suffix, 0), size};
+        }
+        const auto begin = std::stoll(first);
+        auto end = last.empty() ? size : std::stoll(last) + 1;
+        end = std::min(end, size);
+        if (begin < 0 || begin >= end) {
+            return std::nullopt;
+        }
+        return ByteRange {begin, end};
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+}  // namespace
+
+BlobController::BlobController(
+    const std::shared_ptr<ResourceProvider>& resource_provider,
+    const std::shared_ptr<oatpp::web::mime::ContentMappers>& apiContentMappers
+) :
+    oatpp::web::server::api::ApiController(apiContentMappers),
+    m_resource_provider(resource_provider) {}
+
+std::shared_ptr<OutgoingResponse> BlobController::get_blob(
+    const oatpp::String& digest,
+    const std::shared_ptr<IncomingRequest>& request
+) {
+    const auto resource = parse_digest(digest);
+    if (!resource) {
+        return createResponse(Status::CODE_400, "invalid digest");
+    }
+    const auto path = m_resource_provider->get_resource(*resource);
+    if (!is_verified(path, *resource)) {
+        return createResponse(Status::CODE_404, "blob not found");
+    }
+    std::error_code error_code;
+    const auto size =
+        static_cast<int64_t>(std::filesystem::file_size(path, error_code));
+    if (error_code) {
+        return createResponse(Status::CODE_404, "blob not found");
+    }
+
+    auto status = Status::CODE_200;
+    ByteRange range {0, size};
+    const auto range_header = request->getHeader("Range");
+    if (range_header) {
+        const auto requested = parse_range(*range_header, size);
+        if (!requested) {
+            auto response = createResponse(Status::CODE_416);
+            response->putHeader(
+                "Content-Range",
+                "bytes */" + std::to_string(size)
+            );
+            return response;
+        }
+        status = Status::CODE_206;
+        range = *requested;
+    }
+
+    auto response = OutgoingResponse::createShared(
+        status,
+        std::make_shared<FileRangeBody>(
+            path,
+            range.begin,
+            range.end - range.begin
+        )
+    );
+    response->putHeader("Content-Type", "application/octet-stream");
+    response->putHeader("Accept-Ranges", "bytes");
+    response->putHeader("ETag", "\"sha256:" + *resource + "\"");
+    if (status == Status::CODE_206) {
+        response->putHeader(
+            "Content-Range",
+            "bytes " + std::to_string(range.begin) + "-"
+                + std::to_string(range.end - 1) + "/" + std::to_string(size)
+        );
+    }
+    return response;
+}
@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file blob_controller.hpp
+ * @brief Serving local blobs to other nodes
+ **/
+
+#pragma once
+
+#include <memory>
+
+#include <oatpp/macro/codegen.hpp>
+#include <oatpp/macro/component.hpp>
+#include <oatpp/web/server/api/ApiController.hpp>
+
+#include "model/resource.hpp"
+
+#include OATPP_CODEGEN_BEGIN(ApiController)  //<-- Begin Codegen
+
+/**
+ * Read-only access to the verified blobs, so a node can be a mirror for its
+ * neighbours. Blobs which weren't verified yet, including downloads in
+ * progress, are not served.
+ */
+class BlobController: public oatpp::web::server::api::ApiController {
+  public:
+    BlobController(
+        const std::shared_ptr<ResourceProvider>& resource_provider,
+        OATPP_COMPONENT(
+            const std::shared_ptr<oatpp::web::mime::ContentMappers>,
+            apiContentMappers
+        )
+    );
+
+  public:
+    ENDPOINT(
+        "GET",
+        "/hailo/v1/blob/{digest}",
+        get_blob,
+        PATH(String, digest),
+        REQUEST(std::shared_ptr<IncomingRequest>, request)
+    );
+
+  private:
+    std::shared_ptr<ResourceProvider> m_resource_provider;
+};
+
+#include OATPP_CODEGEN_END(ApiController)  //<-- End Codegen
@@ -10,13 +10,15 @@
 #include "controller.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <sstream>
 #include <string>
 #include <system_error>
-#include <thread>
+#include <utility>
+#include <vector>
 
 #include <hailo/genai/llm/llm.hpp>
 #include <minja/chat-template.hpp>
@@ -28,13 +30,22 @@
 #include <oatpp/web/server/api/ApiController.hpp>
 
 #include "config/static_config.hpp"
+#include "controller/drain_gate.hpp"
 #include "controller/llm_generation_callback.hpp"
 #include "controller/pull_callback.hpp"
+#include "controller/pull_registry.hpp"
+#include "download/progress_channel.hpp"
+#include "download/throttle.hpp"
 #include "dto/DTOs.hpp"
 #include "generation_context/generation_context.hpp"
+#include "logging/log_policy.hpp"
+#include "metrics/server_metrics.hpp"
+#include "model/blob_store.hpp"
+#include "model/importer.hpp"
 #include "model/resource.hpp"
 #include "model/store.hpp"
 #include "oatpp/Types.hpp"
+#include "tracing/tracer.hpp"
 #include "utils/time.hpp"
 
 using json = nlohmann::ordered_json;
@@ -80,21 +91,86 @@ void set_options(
         generation.max_generated_tokens = options->num_predict;
     }
 }
+
+std::string render_prompt(
+    const TemplateParamsInfo& params,
+    const minja::chat_template_inputs& inputs
+) {
+    std::optional<minja::chat_template> templ;
+    {
+        TRACE_SPAN("template construct");
+        templ.emplace(params.chat_template, params.bos_token, params.eos_token);
+    }
+    TRACE_SPAN("template render");
+    return templ->apply(inputs);
+}
+// stops the import once the throttle is cancelled
+ImportOptions::Progress import_progress(
+    std::shared_ptr<DownloadThrottle> throttle,
+    std::shared_ptr<PullProgressChannel> channel
+) {
+    return [throttle = std::move(throttle), channel = std::move(channel)](
+               const std::string& digest,
+               uint64_t total,
+               uint64_t completed
+           ) {
+        throttle->consume(0);
+        if (channel) {
+            channel->progress(
+                digest,
+                static_cast<int64_t>(total),
+                static_cast<int64_t>(completed)
+            );
+        }
+    };
+}
 }  // namespace
 
 MyController::MyController(
     const std::shared_ptr<SyncGenerationContext>& generation_context,
     const std::shared_ptr<ModelStore>& model_store,
     const std::shared_ptr<ResourceProvider>& resource_provider,
+    const std::shared_ptr<BlobStore>& blob_store,
+    const std::shared_ptr<ModelImporter>& importer,
+    const std::shared_ptr<HefPrefetcher>& prefetcher,
+    const std::shared_ptr<DrainGate>& drain_gate,
+    const std::shared_ptr<PullRegistry>& pulls,
+    const std::shared_ptr<ServerMetrics>& metrics,
     const std::shared_ptr<oatpp::web::mime::ContentMappers>& apiContentMappers
 ) :
     oatpp::web::server::api::ApiController(apiContentMappers),
     m_generation_context(generation_context),
     m_model_store(model_store),
-    m_resource_provider(resource_provider) {}
+    m_resource_provider(resource_provider),
+    m_blob_store(blob_store),
+    m_importer(importer),
+    m_prefetcher(prefetcher),
+    m_drain_gate(drain_gate),
+    m_pulls(pulls),
+    m_metrics(metrics),
+    m_model_info_cache(metrics) {}
+
+SyncGenerationContext::handle
+MyController::lock_generation_context(const std::filesystem::path& hef) {
+    TRACE_SPAN("queue wait");
+    const auto begin = std::chrono::steady_clock::now();
+    auto generator = m_generation_context->try_lock();
+    if (!generator) {
+        // another request holds the device -> the load comes after it
+        if (m_prefetcher) {
+            m_prefetcher->prefetch(hef);
+        }
+        generator = m_generation_context->lock();
+    }
+    if (m_metrics) {
+        m_metrics->queue_waited(std::chrono::steady_clock::now() - begin);
+    }
+    return generator;
+}
 
 std::optional<std::pair<ModelInfo, std::filesystem::path>>
 MyController::get_model_data(const std::string& model_name) {
+    TRACE_SPAN("get_model_data");
     const auto model_data_opt = m_model_store->get_model(model_name);
     if (!model_data_opt) {
         return std::nullopt;
@@ -108,38 +184,80 @@ MyController::get_model_data(const std::string& model_name) {
     return {{model_data, hef}};
 }
 
+void MyController::sync_model_info_cache() {
+    // both versions only grow -> the sum changes whenever either one does
+    m_model_info_cache.sync(
+        m_model_store->get_version() + m_blob_store->get_version()
+    );
+}
+
+std::optional<CachedModelInfo>
+MyController::get_cached_info(const std::string& model_name) {
+    sync_model_info_cache();
+    return m_model_info_cache.get_info(
+        model_name,
+        [this, &model_name]() -> std::optional<CachedModelInfo> {
+            // the summary doesn't require parsing the whole manifest
+            const auto summary = m_model_store->get_model_summary(model_name);
+            if (!summary) {
+                return std::nullopt;
+            }
+            const auto hef =
+                m_resource_provider->get_resource(summary->hef_resource);
+            if (!fs::is_regular_file(hef)) {
+                return std::nullopt;
+            }
+            std::error_code error_code;
+            const auto modified_at = fs::last_write_time(hef, error_code);
+            if (error_code) {
+                return std::nullopt;
+            }
+            const auto file_size = fs::file_size(hef, error_code);
+            if (error_code) {
+                return std::nullopt;
+            }
+            CachedModelInfo info {
+                .size = file_size,
+                .modified_at = to_iso_8601(modified_at, "Z"),
+                .details = nullptr,
+            };
+            if (!summary->details.empty()) {
+                info.details =
+                    m_contentMappers->getDefaultMapper()
+                        ->readFromString<oatpp::Object<ModelInfoDetails>>(
+                            summary->details
+                        );
+            }
+            return info;
+        }
+    );
+}
+
 std::optional<oatpp::Object<ModelInfoShort>>
 MyController::get_model_info(const std::string& model_name) {
-    const auto model_data_opt = get_model_data(model_name);
-    if (!model_data_opt) {
-        return std::nullopt;
-    }
-    const auto& model_data = model_data_opt->first;
-    const auto& hef = model_data_opt->second;
-    std::error_code error_code;
-    const auto modified_at = fs::last_write_time(hef, error_code);
-    if (error_code) {
-        return std::nullopt;
-    }
-    const auto file_size = fs::file_size(hef, error_code);
-    if (error_code) {
+    const auto info_opt = get_cached_info(model_name);
+    if (!info_opt) {
         return std::nullopt;
     }
+    // always a fresh DTO - callers are allowed to modify it
     auto model_info = ModelInfoShort::createShared();
     model_info->name = model_name;
     model_info->model = model_name;
-    model_info->size = file_size;
-    model_info->modified_at = to_iso_8601(modified_at, "Z");
-    if (!model_data.details.empty()) {
-        model_info->details =
-            m_contentMappers->getDefaultMapper()
-                ->readFromString<oatpp::Object<ModelInfoDetails>>(
-                    model_data.details
-                );
-    }
+    model_info->size = info_opt->size;
+    model_info->modified_at = info_opt->modified_at;
+    model_info->details = info_opt->details;
     return model_info;
 }
 
+std::shared_ptr<oat::OutgoingResponse> MyController::draining_response() {
+    auto error_result = ErrorResponse::createShared();
+    error_result->error = "server is shutting down";
+    auto response = createDtoResponse(Status::CODE_503, error_result);
+    // the next request goes to a new connection, maybe to another server
+    response->putHeader("Connection", "close");
+    return response;
+}
+
 std::optional<std::chrono::seconds>
 MyController::convert_keep_alive(const oatpp::Int32& keep_alive) {
     if (!keep_alive) {
@@ -163,8 +281,16 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
 ) {
     using GenerationStatus = hailort::genai::LLMGeneratorCompletion::Status;
 
+    const auto request_begin = std::chrono::steady_clock::now();
+    auto ticket = m_drain_gate->enter();
+    if (!ticket) {
+        return draining_response();
+    }
     const auto hef = m_resource_provider->get_resource(model_data.hef_resource);
     OATPP_LOGi("handle_completion", "Got model {}", hef.string());
+    // not evicted while queued, once loaded the blob store keeps it anyway
+    const auto pin = m_blob_store->pin(model_data.hef_resource);
+    m_blob_store->touch(model_data.hef_resource);
     Generation generation {
         .model_name = model_data.name,
         .model_path = hef,
@@ -183,7 +309,8 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
         }
     }
     set_options(options, generation);
-    auto generator = m_generation_context->lock();
+    auto generator = lock_generation_context(hef);
+    ServerMetrics::LockHold lock_hold(m_metrics);
     auto generator_completion = generator->generate_one(std::move(generation));
     const auto& stop_tokens = model_data.generation_params.stop_tokens;
     if (!stream) {
@@ -193,6 +320,7 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
         const std::chrono::steady_clock::time_point begin =
             std::chrono::steady_clock::now();
         bool stop_token_encountered = false;
+        std::optional<std::chrono::steady_clock::time_point> first_token;
         while (true) {
             const auto status = generator_completion.generation_status();
             if (status == GenerationStatus::LOGICAL_END_OF_GENERATION) {
@@ -203,8 +331,13 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
                 break;
             }
 
-            const auto output =
-                generator_completion.read().expect("read failed!");
+            const auto output = read_token(generator_completion);
+            if (!first_token) {
+                first_token = std::chrono::steady_clock::now();
+                if (m_metrics) {
+                    m_metrics->first_token(model, *first_token - request_begin);
+                }
+            }
 
             // check status immediately after read to see if it's the last one
             const auto is_last_token =
@@ -234,8 +367,7 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
             if (status != GenerationStatus::GENERATING) {
                 break;
             }
-            const auto output =
-                generator_completion.read().expect("read failed!");
+            const auto output = read_token(generator_completion);
 
             // check status immediately after read to see if it's the last one
             const auto is_last_token =
@@ -252,6 +384,13 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
         const std::chrono::steady_clock::time_point end =
             std::chrono::steady_clock::now();
         std::string stop_reason = stop_token_encountered ? "stop" : "length";
+        if (m_metrics && first_token) {
+            m_metrics->generation_finished(
+                model,
+                token_count,
+                end - *first_token
+            );
+        }
 
         if (return_type == ReturnType::COMPLETION) {
             auto result = CreateChatCompletionResponse::createShared();
@@ -273,6 +412,7 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
             choice->message = message;
 
             result->choices->push_back(choice);
+            TRACE_SPAN("encode response");
             return createDtoResponse(Status::CODE_200, result);
         }
         auto result = GenerationResponseFinal::createShared();
@@ -293,8 +433,10 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
                 .count();
         result->total_duration = total_time_ns;
+        result->load_duration = generator->get_load_duration().count();
         result->eval_count = token_count;
 
+        TRACE_SPAN("encode response");
         return createDtoResponse(Status::CODE_200, result);
     }
     auto body = std::make_shared<oat::OutgoingStreamingBody>(
@@ -304,7 +446,11 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_completion(
             m_contentMappers->getDefaultMapper(),
             std::move(generator),
             std::move(generator_completion),
-            return_type == ReturnType::MESSAGE
+            return_type == ReturnType::MESSAGE,
+            std::move(*ticket),
+            m_metrics,
+            request_begin,
+            std::move(lock_hold)
         )
     );
 
@@ -322,10 +468,14 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_load_unload(
     const bool return_as_message
 ) {
     (void)options;
+    const auto ticket = m_drain_gate->enter();
+    if (!ticket) {
+        return draining_response();
+    }
     // keep alive is 0 -> should unload the model
     auto result = GenerationResponseFinal::createShared();
-    auto generator = m_generation_context->lock();
     if (keep_alive && *keep_alive == 0) {
+        auto generator = m_generation_context->lock();
         generator->reset();
 
         result->done_reason = "unload";
@@ -333,7 +483,12 @@ std::shared_ptr<oat::OutgoingResponse> MyController::handle_load_unload(
         // Model load
         const auto hef =
             m_resource_provider->get_resource(model_data.hef_resource);
+        const auto pin = m_blob_store->pin(model_data.hef_resource);
+        auto generator = lock_generation_context(hef);
+        const ServerMetrics::LockHold lock_hold(m_metrics);
         generator->load_model(model_name, hef, convert_keep_alive(keep_alive));
+        result->load_duration = generator->get_load_duration().count();
+        m_blob_store->touch(model_data.hef_resource);
         result->done_reason = "load";
     }
     result->model = model_name;
@@ -356,6 +511,13 @@ std::shared_ptr<oat::OutgoingResponse> MyController::root() {
     );
 }
 
+std::shared_ptr<oat::OutgoingResponse> MyController::ready() {
+    if (m_drain_gate->draining()) {
+        return ResponseFactory::createResponse(Status::CODE_503, "draining");
+    }
+    return ResponseFactory::createResponse(Status::CODE_200, "ready");
+}
+
 std::shared_ptr<oat::OutgoingResponse> MyController::version() {
     auto result = VersionResponse::createShared();
     // tools might rely on this -> return a version similar to original Ollama
@@ -363,20 +525,45 @@ std::shared_ptr<oat::OutgoingResponse> MyController::version() {
     return createDtoResponse(Status::CODE_200, result);
 }
 
-std::shared_ptr<oat::OutgoingResponse> MyController::list_models() {
-    const auto model_names = m_model_store->get_model_names();
-    OATPP_LOGi("list_models", "got {} models in store", model_names.size());
-    auto result = TagsResponse::createShared();
-    result->models = {};
-    for (const auto& model_name : model_names) {
-        OATPP_LOGi("list_models", "model: {}", model_name);
-        const auto model_info = get_model_info(model_name);
-        if (!model_info) {
-            continue;
+std::shared_ptr<oat::OutgoingResponse> MyController::list_models(
+    const std::shared_ptr<IncomingRequest>& request
+) {
+    sync_model_info_cache();
+    const auto tags = m_model_info_cache.get_tags([this]() {
+        const auto model_names = m_model_store->get_model_names();
+        OATPP_LOGi(
+            "list_models",
+            "got {} models in store",
+            model_names.size()
+        );
+        auto result = TagsResponse::createShared();
+        result->models = {};
+        for (const auto& model_name : model_names) {
+            if (m_model_log_sampler.sample()) {
+                OATPP_LOGi("list_models", "model: {}", model_name);
+            }
+            const auto model_info = get_model_info(model_name);
+            if (!model_info) {
+                continue;
+            }
+            result->models->push_back(*model_info);
         }
-        result->models->push_back(*model_info);
-    }
-    return createDtoResponse(Status::CODE_200, result);
+        return m_contentMappers->getDefaultMapper()
+            ->writeToString(result)
+            .getValue("");
+    });
+
+    const auto if_none_match = request->getHeader("If-None-Match");
+    if (if_none_match
+        && ModelInfoCache::etag_matches(*if_none_match, tags.etag)) {
+        auto response = createResponse(Status::CODE_304);
+        response->putHeader("ETag", tags.etag);
+        return response;
+    }
+    auto response = createResponse(Status::CODE_200, tags.body);
+    response->putHeader("Content-Type", "application/json");
+    response->putHeader("ETag", tags.etag);
+    return response;
 }
 
 std::shared_ptr<oat::OutgoingResponse> MyController::list_all_models() {
@@ -391,6 +578,23 @@ std::shared_ptr<oat::OutgoingResponse> MyController::list_all_models() {
     return createDtoResponse(Status::CODE_200, result);
 }
 
+std::shared_ptr<oat::OutgoingResponse> MyController::list_blobs() {
+    const auto usage = m_blob_store->usage();
+    auto result = BlobsResponse::createShared();
+    result->quota = usage.quota_bytes;
+    result->used = usage.used_bytes;
+    result->partial = usage.temp_bytes;
+    result->blobs = {};
+    for (const auto& blob : usage.blobs) {
+        auto info = BlobInfo::createShared();
+        info->digest = "sha256:" + blob.digest;
+        info->size = blob.size;
+        info->last_used = to_iso_8601(blob.last_used, "Z");
+        result->blobs->push_back(info);
+    }
+    return createDtoResponse(Status::CODE_200, result);
+}
+
 std::shared_ptr<oat::OutgoingResponse> MyController::list_running_models() {
     auto generator = m_generation_context->lock();
     const auto model_name = generator->get_model_name();
@@ -410,13 +614,16 @@ std::shared_ptr<oat::OutgoingResponse> MyController::list_running_models() {
 
 std::shared_ptr<oat::OutgoingResponse>
 MyController::show(const oatpp::Object<ShowParams>& show_params) {
-    const auto model_data_opt = get_model_data(show_params->model);
-    if (!model_data_opt) {
+    const auto model_data_opt = m_model_store->get_model(show_params->model);
+    const auto info_opt = model_data_opt
+        ? get_cached_info(show_params->model)
+        : std::nullopt;
+    if (!info_opt) {
         auto error_result = ErrorResponse::createShared();
         error_result->error = "model '" + show_params->model + "' not found";
         return createDtoResponse(Status::CODE_200, error_result);
     }
-    const auto& model_data = model_data_opt->first;
+    const auto& model_data = *model_data_opt;
     auto result = ShowResponse::createShared();
     result->license = model_data.license;
     result->modelfile = "";
@@ -434,19 +641,9 @@ MyController::show(const oatpp::Object<ShowParams>& show_params) {
     }
     result->parameters = std::move(parameters_string);
     result->chat_template = model_data.template_params.chat_template;
-    if (!model_data.details.empty()) {
-        result->details = m_contentMappers->getDefaultMapper()
-                              ->readFromString<oatpp::Object<ModelInfoDetails>>(
-                                  model_data.details
-                              );
-    }
+    result->details = info_opt->details;
     result->model_info = "";
-    std::error_code error_code;
-    const auto& hef = model_data_opt->second;
-    const auto modified_at = fs::last_write_time(hef, error_code);
-    if (!error_code) {
-        result->modified_at = to_iso_8601(modified_at, "Z");
-    }
+    result->modified_at = info_opt->modified_at;
     return createDtoResponse(Status::CODE_200, result);
 }
 
@@ -459,25 +656,45 @@ MyController::pull_model(const oatpp::Object<PullParams>& pull_params) {
         return createDtoResponse(Status::CODE_200, error_result);
     }
 
+    if (m_drain_gate->draining()) {
+        return draining_response();
+    }
+    const PullOptions options {.verify = pull_params->verify == true};
+    const auto hef_resource = model_data->hef_resource;
     if (!pull_params->stream) {
-        m_resource_provider->pull_resource(model_data->hef_resource);
+        m_pulls->run([&](const std::shared_ptr<DownloadThrottle>& throttle) {
+            auto pull_options = options;
+            pull_options.throttle = throttle;
+            m_resource_provider->pull_resource(hef_resource, pull_options);
+        });
+        m_model_info_cache.invalidate();
         auto result = PullResponse::createShared();
         result->status = "success";
 
         return createDtoResponse(Status::CODE_200, result);
     }
 
-    auto queue = std::make_shared<PullReadCallback::EventQueue>();
-    std::thread pull_thread(
-        [this, &model_data, queue, hef_resource = model_data->hef_resource]() {
-            m_resource_provider->pull_resource(hef_resource, queue);
+    auto channel = std::make_shared<PullProgressChannel>();
+    // the registry joins the thread before the controller goes away
+    m_pulls->start(
+        [this, channel, options, hef_resource](
+            const std::shared_ptr<DownloadThrottle>& throttle
+        ) {
+            auto pull_options = options;
+            pull_options.throttle = throttle;
+            // errors are sent to the channel
+            m_resource_provider->pull_resource(
+                hef_resource,
+                pull_options,
+                channel
+            );
+            m_model_info_cache.invalidate();
         }
     );
     auto body = std::make_shared<oat::OutgoingStreamingBody>(
         std::make_shared<PullReadCallback>(
             m_contentMappers->getDefaultMapper(),
-            queue,
-            std::move(pull_thread)
+            channel
         )
     );
 
@@ -487,6 +704,77 @@ MyController::pull_model(const oatpp::Object<PullParams>& pull_params) {
     return outgoing_response;
 }
 
+std::shared_ptr<oat::OutgoingResponse>
+MyController::import_models(const oatpp::Object<ImportParams>& import_params) {
+    if (!import_params->path) {
+        auto error_result = ErrorResponse::createShared();
+        error_result->error = "path is required";
+        return createDtoResponse(Status::CODE_400, error_result);
+    }
+    if (m_drain_gate->draining()) {
+        return draining_response();
+    }
+    const ImportOptions options {.move = import_params->move == true};
+    const std::string path = *import_params->path;
+    // imports run like pulls: counted by the drain, cancelled at shutdown
+    if (import_params->stream) {
+        auto channel = std::make_shared<PullProgressChannel>();
+        m_pulls->start(
+            [this, channel, path, options](
+                const std::shared_ptr<DownloadThrottle>& throttle
+            ) {
+                auto import_options = options;
+                import_options.progress = import_progress(throttle, channel);
+                try {
+                    for (const auto& name :
+                         m_importer->import(path, import_options)) {
+                        channel->status("imported " + name);
+                    }
+                    channel->status("success");
+                } catch (const std::exception& e) {
+                    channel->error(e.what());
+                }
+                // some blobs may be in place even after an error
+                m_model_info_cache.invalidate();
+                channel->done();
+            }
+        );
+        auto body = std::make_shared<oat::OutgoingStreamingBody>(
+            std::make_shared<PullReadCallback>(
+                m_contentMappers->getDefaultMapper(),
+                channel
+            )
+        );
+        auto outgoing_response =
+            OutgoingResponse::createShared(Status::CODE_200, body);
+        outgoing_response->putHeader("Content-Type", "application/x-ndjson");
+        return outgoing_response;
+    }
+
+    std::vector<std::string> names;
+    try {
+        m_pulls->run([&](const std::shared_ptr<DownloadThrottle>& throttle) {
+            auto import_options = options;
+            import_options.progress = import_progress(throttle, nullptr);
+            names = m_importer->import(path, import_options);
+        });
+    } catch (const std::exception& e) {
+        // some blobs may be in place already
+        m_model_info_cache.invalidate();
+        auto error_result = ErrorResponse::createShared();
+        error_result->error = e.what();
+        return createDtoResponse(Status::CODE_400, error_result);
+    }
+    m_model_info_cache.invalidate();
+
+    auto result = ImportResponse::createShared();
+    result->models = {};
+    for (const auto& name : names) {
+        result->models->push_back(name);
+    }
+    return createDtoResponse(Status::CODE_200, result);
+}
+
 std::shared_ptr<oat::OutgoingResponse>
 MyController::delete_model(const oatpp::Object<DeleteParams>& delete_params) {
     auto model_data = m_model_store->get_model(delete_params->model);
@@ -496,11 +784,10 @@ MyController::delete_model(const oatpp::Object<DeleteParams>& delete_params) {
         error_result->error = "model not found";
         return createDtoResponse(Status::CODE_404, error_result);
     }
-    const auto hef =
-        m_resource_provider->get_resource(model_data->hef_resource);
-    std::error_code error_code;
-    const auto removed = fs::remove(hef, error_code);
-    if (error_code || !removed) {
+    const auto removed =
+        m_resource_provider->remove_resource(model_data->hef_resource);
+    m_model_info_cache.invalidate();
+    if (!removed) {
         auto error_result = DeleteErrorResponse::createShared();
         error_result->code = "not_found";
         error_result->error = "model not found";
@@ -513,6 +800,8 @@ MyController::delete_model(const oatpp::Object<DeleteParams>& delete_params) {
 std::shared_ptr<oat::OutgoingResponse> MyController::generate(
     const oatpp::Object<GenerationParams>& generation_params
 ) {
+    // the body is read and mapped before the endpoint is called
+    TRACE_SINCE_REQUEST("parse body");
     const auto& model = generation_params->model;
 
     const auto model_data_opt = get_model_data(model);
@@ -532,12 +821,6 @@ std::shared_ptr<oat::OutgoingResponse> MyController::generate(
             false
         );
     }
-    minja::chat_template templ(
-        model_data.template_params.chat_template,
-        model_data.template_params.bos_token,
-        model_data.template_params.eos_token
-    );
-
     const auto& prompt = generation_params->prompt;
     const auto stream = generation_params->stream;
 
@@ -545,7 +828,8 @@ std::shared_ptr<oat::OutgoingResponse> MyController::generate(
     inputs.add_generation_prompt = true;
     inputs.messages = json {{{"role", "user"}, {"content", prompt}}};
 
-    const std::string prompt_templ = templ.apply(inputs);
+    const std::string prompt_templ =
+        render_prompt(model_data.template_params, inputs);
 
     return handle_completion(
         model_data,
@@ -560,6 +844,8 @@ std::shared_ptr<oat::OutgoingResponse> MyController::generate(
 
 std::shared_ptr<oat::OutgoingResponse>
 MyController::chat(const oatpp::Object<ChatParams>& generation_params) {
+    // the body is read and mapped before the endpoint is called
+    TRACE_SINCE_REQUEST("parse body");
     const auto& model = generation_params->model;
     const auto model_data_opt = get_model_data(model);
     if (!model_data_opt) {
@@ -578,12 +864,6 @@ MyController::chat(const oatpp::Object<ChatParams>& generation_params) {
             true
         );
     }
-    minja::chat_template templ(
-        model_data.template_params.chat_template,
-        model_data.template_params.bos_token,
-        model_data.template_params.eos_token
-    );
-
     const auto stream = generation_params->stream;
 
     minja::chat_template_inputs inputs;
@@ -593,7 +873,8 @@ MyController::chat(const oatpp::Object<ChatParams>& generation_params) {
                         ->writeToString(generation_params->messages)
                         .getValue(""));
 
-    const std::string prompt_templ = templ.apply(inputs);
+    const std::string prompt_templ =
+        render_prompt(model_data.template_params, inputs);
 
     return handle_completion(
         model_data,
@@ -609,6 +890,8 @@ MyController::chat(const oatpp::Object<ChatParams>& generation_params) {
 std::shared_ptr<oat::OutgoingResponse> MyController::chat_completions(
     const oatpp::Object<CreateChatCompletionParams>& generation_params
 ) {
+    // the body is read and mapped before the endpoint is called
+    TRACE_SINCE_REQUEST("parse body");
     if (!generation_params->messages) {
         auto error_result = ErrorResponse::createShared();
         error_result->error = "messages field is required";
@@ -634,12 +917,6 @@ std::shared_ptr<oat::OutgoingResponse> MyController::chat_completions(
     }
     const auto& model_data = model_data_opt->first;
 
-    minja::chat_template templ(
-        model_data.template_params.chat_template,
-        model_data.template_params.bos_token,
-        model_data.template_params.eos_token
-    );
-
     const auto stream = generation_params->stream;
 
     minja::chat_template_inputs inputs;
@@ -649,7 +926,8 @@ std::shared_ptr<oat::OutgoingResponse> MyController::chat_completions(
                         ->writeToString(generation_params->messages)
                         .getValue(""));
 
-    const std::string prompt_templ = templ.apply(inputs);
+    const std::string prompt_templ =
+        render_prompt(model_data.template_params, inputs);
 
     auto model_options = ModelParameters::createShared();
     model_options->temperature = generation_params->temperature;
@@ -21,8 +21,16 @@
 #include <oatpp/web/protocol/http/outgoing/StreamingBody.hpp>
 #include <oatpp/web/server/api/ApiController.hpp>
 
+#include "controller/drain_gate.hpp"
+#include "controller/model_info_cache.hpp"
+#include "controller/pull_registry.hpp"
 #include "dto/DTOs.hpp"
 #include "generation_context/generation_context.hpp"
+#include "generation_context/prefetcher.hpp"
+#include "logging/log_policy.hpp"
+#include "metrics/server_metrics.hpp"
+#include "model/blob_store.hpp"
+#include "model/importer.hpp"
 #include "model/resource.hpp"
 #include "model/store.hpp"
 
@@ -43,6 +51,12 @@ class MyController: public oatpp::web::server::api::ApiController {
         const std::shared_ptr<SyncGenerationContext>& generation_context,
         const std::shared_ptr<ModelStore>& model_store,
         const std::shared_ptr<ResourceProvider>& resource_provider,
+        const std::shared_ptr<BlobStore>& blob_store,
+        const std::shared_ptr<ModelImporter>& importer,
+        const std::shared_ptr<HefPrefetcher>& prefetcher,
+        const std::shared_ptr<DrainGate>& drain_gate,
+        const std::shared_ptr<PullRegistry>& pulls,
+        const std::shared_ptr<ServerMetrics>& metrics,
         OATPP_COMPONENT(
             const std::shared_ptr<oatpp::web::mime::ContentMappers>,
             apiContentMappers
@@ -52,9 +66,17 @@ class MyController: public oatpp::web::server::api::ApiController {
   public:
     ENDPOINT("GET", "/", root);
     ENDPOINT("GET", "/api/version", version);
+    // 503 once the server drains for shutdown
+    ENDPOINT("GET", "/hailo/v1/ready", ready);
 
-    ENDPOINT("GET", "/api/tags", list_models);
+    ENDPOINT(
+        "GET",
+        "/api/tags",
+        list_models,
+        REQUEST(std::shared_ptr<IncomingRequest>, request)
+    );
     ENDPOINT("GET", "/hailo/v1/list", list_all_models);
+    ENDPOINT("GET", "/hailo/v1/blobs", list_blobs);
     ENDPOINT("GET", "/api/ps", list_running_models);
 
     ENDPOINT(
@@ -71,6 +93,13 @@ class MyController: public oatpp::web::server::api::ApiController {
         BODY_DTO(Object<PullParams>, pull_params)
     );
 
+    ENDPOINT(
+        "POST",
+        "/hailo/v1/import",
+        import_models,
+        BODY_DTO(Object<ImportParams>, import_params)
+    );
+
     ENDPOINT(
         "DELETE",
         "/api/delete",
@@ -121,9 +150,19 @@ class MyController: public oatpp::web::server::api::ApiController {
     std::optional<std::pair<ModelInfo, std::filesystem::path>>
     get_model_data(const std::string& model_name);
 
+    void sync_model_info_cache();
+    std::optional<CachedModelInfo>
+    get_cached_info(const std::string& model_name);
+
     std::optional<Object<ModelInfoShort>>
     get_model_info(const std::string& model_name);
 
+    // waits for the device, warming the page cache with the HEF meanwhile
+    SyncGenerationContext::handle
+    lock_generation_context(const std::filesystem::path& hef);
+
+    std::shared_ptr<OutgoingResponse> draining_response();
+
     static std::optional<std::chrono::seconds>
     convert_keep_alive(const oatpp::Int32& keep_alive);
 
@@ -131,6 +170,16 @@ class MyController: public oatpp::web::server::api::ApiController {
     std::shared_ptr<SyncGenerationContext> m_generation_context;
     std::shared_ptr<ModelStore> m_model_store;
     std::shared_ptr<ResourceProvider> m_resource_provider;
+    std::shared_ptr<BlobStore> m_blob_store;
+    std::shared_ptr<ModelImporter> m_importer;
+    std::shared_ptr<HefPrefetcher> m_prefetcher;
+    std::shared_ptr<DrainGate> m_drain_gate;
+    std::shared_ptr<PullRegistry> m_pulls;
+    // null when metrics are disabled
+    std::shared_ptr<ServerMetrics> m_metrics;
+    ModelInfoCache m_model_info_cache;
+    // one line per model would flood the log for a large catalog
+    logging::Sampler m_model_log_sampler;
 };
 
 #include OATPP_CODEGEN_END(ApiController)  //<-- End Codegen
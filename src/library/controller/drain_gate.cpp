@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file drain_gate.cpp
+ * @brief DrainGate implementation
+ **/
+
+#include "controller/drain_gate.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+DrainGate::Ticket::Ticket(DrainGate& gate) : m_gate(&gate) {}
+
+DrainGate::Ticket::~Ticket() {
+    if (m_gate) {
+        m_gate->leave();
+    }
+}
+
+DrainGate::Ticket::Ticket(Ticket&& other) noexcept : m_gate(other.m_gate) {
+    other.m_gate = nullptr;
+}
+
+DrainGate::DrainGate() : m_active(0), m_draining(false) {}
+
+std::optional<DrainGate::Ticket> DrainGate::enter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_draining) {
+            return std::nullopt;
+        }
+        ++m_active;
+    }
+    return std::optional<Ticket>(std::in_place, *this);
+}
+
+void DrainGate::drain() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_draining = true;
+}
+
+bool DrainGate::draining() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_draining;
+}
+
+size_t DrainGate::active() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_active;
+}
+
+bool DrainGate::wait_idle(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_idle.wait_until(lock, deadline, [this]() {
+        return m_active == 0;
+    });
+}
+
+void DrainGate::leave() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_active == 0) {
+        m_idle.notify_all();
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file drain_gate.hpp
+ * @brief Admission of generations and waiting for them at shutdown
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+/**
+ * Counts the generations in progress. Once draining, no new generation is
+ * admitted and the shutdown waits for the running ones to finish - a
+ * streamed generation holds its ticket until the last chunk was sent.
+ */
+class DrainGate {
+  public:
+    class Ticket {
+      public:
+        explicit Ticket(DrainGate& gate);
+        ~Ticket();
+        Ticket(Ticket&& other) noexcept;
+        Ticket& operator=(Ticket&& other) = delete;
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+      private:
+        DrainGate* m_gate;
+    };
+
+    DrainGate();
+
+    // std::nullopt while draining
+    std::optional<Ticket> enter();
+    void drain();
+    bool draining() const;
+    size_t active() const;
+    // false if generations were still running at the deadline
+    bool wait_idle(std::chrono::steady_clock::time_point deadline);
+
+  private:
+    void leave();
+
+  private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_idle;
+    size_t m_active;
+    bool m_draining;
+};
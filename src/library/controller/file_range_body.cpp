@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file file_range_body.cpp
+ * @brief FileRangeBody implementation
+ **/
+
+#include "controller/file_range_body.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+#include <oatpp/base/Log.hpp>
+
+#include "config/static_config.hpp"
+
+FileRangeBody::FileRangeBody(
+    const std::string& path,
+    int64_t offset,
+    int64_t length
+) :
+    m_path(path),
+    m_fd(-1),
+    m_offset(offset),
+    m_length(length),
+    m_read(0),
+    m_buffer_begin(0),
+    m_buffer_end(0) {
+    if (length == 0) {
+        return;
+    }
+    m_fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) {
+        throw std::system_error(
+            errno,
+            std::generic_category(),
+            "Failed to open " + path
+        );
+    }
+    (void)posix_fadvise(m_fd, offset, length, POSIX_FADV_SEQUENTIAL);
+    m_buffer.resize(static_cast<size_t>(std::min<int64_t>(
+        length,
+        static_cast<int64_t>(config::blob_serve_buffer_size)
+    )));
+}
+
+FileRangeBody::~FileRangeBody() {
+    if (m_fd >= 0) {
+        (void)close(m_fd);
+    }
+}
+
+oatpp::v_io_size FileRangeBody::read(
+    void* buffer,
+    v_buff_size count,
+    oatpp::async::Action& action
+) {
+    (void)action;
+    if (m_buffer_begin == m_buffer_end) {
+        if (m_read >= m_length) {
+            return 0;
+        }
+        if (!fill()) {
+            // the promised length can't be sent, the connection is closed
+            return oatpp::IOError::BROKEN_PIPE;
+        }
+    }
+    const auto size = std::min<size_t>(
+        static_cast<size_t>(count),
+        m_buffer_end - m_buffer_begin
+    );
+    std::memcpy(buffer, m_buffer.data() + m_buffer_begin, size);
+    m_buffer_begin += size;
+    return static_cast<oatpp::v_io_size>(size);
+}
+
+bool FileRangeBody::fill() {
+    const auto size = static_cast<size_t>(std::min<int64_t>(
+        static_cast<int64_t>(m_buffer.size()),
+        m_length - m_read
+    ));
+    while (true) {
+        const auto count =
+            pread(m_fd, m_buffer.data(), size, m_offset + m_read);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            OATPP_LOGe(
+                "FileRangeBody",
+                "failed to read {}: {}",
+                m_path,
+                count == 0 ? "unexpected end of file" : std::strerror(errno)
+            );
+            return false;
+        }
+        m_buffer_begin = 0;
+        m_buffer_end = static_cast<size_t>(count);
+        m_read += count;
+        return true;
+    }
+}
+
+void FileRangeBody::declareHeaders(
+    oatpp::web::protocol::http::Headers& headers
+) {
+    (void)headers;
+}
+
+p_char8 FileRangeBody::getKnownData() {
+    // read in chunks, not held in memory
+    return nullptr;
+}
+
+v_int64 FileRangeBody::getKnownSize() {
+    return m_length;
+}
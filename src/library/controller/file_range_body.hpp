@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file file_range_body.hpp
+ * @brief Response body read from a range of a file
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <oatpp/web/protocol/http/outgoing/Body.hpp>
+
+/**
+ * Reads a range of the file with pread() in chunks of a bounded buffer as
+ * oatpp asks for the body. A read error or a file which got shorter fails
+ * the response - a memory mapping would kill the process with SIGBUS
+ * instead.
+ */
+class FileRangeBody: public oatpp::web::protocol::http::outgoing::Body {
+  public:
+    FileRangeBody(const std::string& path, int64_t offset, int64_t length);
+    ~FileRangeBody() override;
+
+    FileRangeBody(const FileRangeBody&) = delete;
+    FileRangeBody& operator=(const FileRangeBody&) = delete;
+
+    oatpp::v_io_size read(
+        void* buffer,
+        v_buff_size count,
+        oatpp::async::Action& action
+    ) override;
+    void declareHeaders(oatpp::web::protocol::http::Headers& headers) override;
+    p_char8 getKnownData() override;
+    v_int64 getKnownSize() override;
+
+  private:
+    // false if the file couldn't be read
+    bool fill();
+
+  private:
+    std::string m_path;
+    int m_fd;
+    // of the range in the file
+    int64_t m_offset;
+    int64_t m_length;
+    // of the next byte of the range read into the buffer
+    int64_t m_read;
+    std::vector<char> m_buffer;
+    size_t m_buffer_begin;
+    size_t m_buffer_end;
+};
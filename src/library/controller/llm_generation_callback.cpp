@@ -13,15 +13,21 @@
 #include <chrono>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <hailo/genai/llm/llm.hpp>
 #include <oatpp/data/mapping/ObjectMapper.hpp>
 #include <oatpp/data/stream/Stream.hpp>
 
+#include "controller/drain_gate.hpp"
 #include "dto/DTOs.hpp"
 #include "generation_context/generation_context.hpp"
+#include "metrics/server_metrics.hpp"
+#include "tracing/tracer.hpp"
 #include "utils/time.hpp"
 
 LLMGenerationReadCallback::LLMGenerationReadCallback(
@@ -30,8 +36,14 @@ LLMGenerationReadCallback::LLMGenerationReadCallback(
     const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& object_mapper,
     SyncGenerationContext::handle&& generation_context,
     hailort::genai::LLMGeneratorCompletion&& generator_completion,
-    const bool return_as_message
+    const bool return_as_message,
+    DrainGate::Ticket&& ticket,
+    const std::shared_ptr<ServerMetrics>& metrics,
+    std::chrono::steady_clock::time_point request_begin,
+    ServerMetrics::LockHold&& lock_hold
 ) :
+    m_ticket(std::move(ticket)),
+    m_lock_hold(std::move(lock_hold)),
     m_model(model),
     m_stop_tokens(stop_tokens),
     m_object_mapper(object_mapper),
@@ -39,6 +51,10 @@ LLMGenerationReadCallback::LLMGenerationReadCallback(
     m_generator_completion(std::move(generator_completion)),
     m_return_as_message(return_as_message),
     m_begin(std::chrono::steady_clock::now()),
+    m_metrics(metrics),
+    m_request_begin(request_begin),
+    m_first_token(),
+    m_last_chunk(),
     m_count(0ULL),
     m_done(false),
     m_response() {}
@@ -48,14 +64,45 @@ oatpp::v_io_size LLMGenerationReadCallback::read(
     v_buff_size bufferSize,
     oatpp::async::Action& action
 ) {
-    using GenerationStatus = hailort::genai::LLMGeneratorCompletion::Status;
     (void)action;  // ignore action when using SimpleAPI
 
+    if (!m_metrics) {
+        return read_chunk(buffer, bufferSize);
+    }
+    // oatpp writes a chunk before it asks for the next one
+    if (m_last_chunk) {
+        m_metrics->stream_written(
+            std::chrono::steady_clock::now() - *m_last_chunk
+        );
+    }
+    const auto size = read_chunk(buffer, bufferSize);
+    m_last_chunk = std::chrono::steady_clock::now();
+    return size;
+}
+
+void LLMGenerationReadCallback::record_token() {
+    if (m_first_token || !m_metrics) {
+        return;
+    }
+    m_first_token = std::chrono::steady_clock::now();
+    m_metrics->first_token(m_model, *m_first_token - m_request_begin);
+}
+
+std::string LLMGenerationReadCallback::encode(const oatpp::Void& chunk) const {
+    TRACE_SPAN("encode chunk");
+    return m_object_mapper->writeToString(chunk).getValue("") + "\r\n";
+}
+
+oatpp::v_io_size
+LLMGenerationReadCallback::read_chunk(void* buffer, v_buff_size bufferSize) {
+    using GenerationStatus = hailort::genai::LLMGeneratorCompletion::Status;
+
     if (m_done) {
         m_generation_context->append_last_prompt(m_response.str());
         return 0;
     }
-    std::string token = m_generator_completion.read().expect("read failed!");
+    std::string token = read_token(m_generator_completion);
+    record_token();
     // check max_tokens first because stop_tokens alters the status
     const auto encountered_max_tokens =
         (m_generator_completion.generation_status()
@@ -75,8 +122,7 @@ oatpp::v_io_size LLMGenerationReadCallback::read(
             // we would like to skip these tokens but current API doesn't allow that
             == GenerationStatus::GENERATING
         ) {
-            const auto token =
-                m_generator_completion.read().expect("read failed!");
+            const auto token = read_token(m_generator_completion);
             const auto is_last_token =
                 (m_generator_completion.generation_status()
                  != GenerationStatus::GENERATING);
@@ -97,6 +143,13 @@ oatpp::v_io_size LLMGenerationReadCallback::read(
         const auto total_time_ns =
             std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_begin)
                 .count();
+        if (m_metrics) {
+            m_metrics->generation_finished(
+                m_model,
+                m_count,
+                end - *m_first_token
+            );
+        }
         auto result = GenerationResponseFinal::createShared();
         result->model = m_model;
         result->created_at = get_current_time_formatted();
@@ -110,9 +163,10 @@ oatpp::v_io_size LLMGenerationReadCallback::read(
         result->done = true;
         result->done_reason = stop_reason;
         result->total_duration = total_time_ns;
+        result->load_duration =
+            m_generation_context->get_load_duration().count();
         result->eval_count = m_count;
-        const auto response =
-            m_object_mapper->writeToString(result).getValue("") + "\r\n";
+        const auto response = encode(result);
         if (response.size() > bufferSize) {
             throw std::runtime_error("Buffer too small");
         }
@@ -133,8 +187,7 @@ oatpp::v_io_size LLMGenerationReadCallback::read(
     } else {
         result->response = std::move(token);
     }
-    const auto response =
-        m_object_mapper->writeToString(result).getValue("") + "\r\n";
+    const auto response = encode(result);
     if (response.size() > bufferSize) {
         throw std::runtime_error("Buffer too small");
     }
@@ -12,6 +12,7 @@
 #include <chrono>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -20,7 +21,9 @@
 #include <oatpp/data/mapping/ObjectMapper.hpp>
 #include <oatpp/data/stream/Stream.hpp>
 
+#include "controller/drain_gate.hpp"
 #include "generation_context/generation_context.hpp"
+#include "metrics/server_metrics.hpp"
 
 class LLMGenerationReadCallback: public oatpp::data::stream::ReadCallback {
   public:
@@ -31,7 +34,11 @@ class LLMGenerationReadCallback: public oatpp::data::stream::ReadCallback {
             object_mapper,
         SyncGenerationContext::handle&& generation_context,
         hailort::genai::LLMGeneratorCompletion&& generator_completion,
-        const bool return_as_message
+        const bool return_as_message,
+        DrainGate::Ticket&& ticket,
+        const std::shared_ptr<ServerMetrics>& metrics,
+        std::chrono::steady_clock::time_point request_begin,
+        ServerMetrics::LockHold&& lock_hold
     );
 
     oatpp::v_io_size read(
@@ -41,6 +48,15 @@ class LLMGenerationReadCallback: public oatpp::data::stream::ReadCallback {
     ) override;
 
   private:
+    oatpp::v_io_size read_chunk(void* buffer, v_buff_size bufferSize);
+    void record_token();
+    // one line of the NDJSON stream
+    std::string encode(const oatpp::Void& chunk) const;
+
+  private:
+    // released last, after the generation context
+    DrainGate::Ticket m_ticket;
+    ServerMetrics::LockHold m_lock_hold;
     std::string m_model;
     std::vector<std::string> m_stop_tokens;
     std::shared_ptr<oatpp::data::mapping::ObjectMapper> m_object_mapper;
@@ -48,6 +64,11 @@ class LLMGenerationReadCallback: public oatpp::data::stream::ReadCallback {
     hailort::genai::LLMGeneratorCompletion m_generator_completion;
     bool m_return_as_message;
     std::chrono::steady_clock::time_point m_begin;
+    std::shared_ptr<ServerMetrics> m_metrics;
+    std::chrono::steady_clock::time_point m_request_begin;
+    std::optional<std::chrono::steady_clock::time_point> m_first_token;
+    // when the previous chunk was handed to oatpp for writing
+    std::optional<std::chrono::steady_clock::time_point> m_last_chunk;
 
     uint64_t m_count;
     bool m_done;
@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics_controller.cpp
+ * @brief MetricsController implementation
+ **/
+
+#include "controller/metrics_controller.hpp"
+
+#include <memory>
+
+#include <oatpp/web/server/api/ApiController.hpp>
+
+#include "metrics/server_metrics.hpp"
+
+MetricsController::MetricsController(
+    const std::shared_ptr<ServerMetrics>& metrics,
+    const std::shared_ptr<oatpp::web::mime::ContentMappers>& apiContentMappers
+) :
+    oatpp::web::server::api::ApiController(apiContentMappers),
+    m_metrics(metrics) {}
+
+std::shared_ptr<oatpp::web::protocol::http::outgoing::Response>
+MetricsController::get_metrics() {
+    auto response = createResponse(Status::CODE_200, m_metrics->render());
+    response->putHeader("Content-Type", "text/plain; version=0.0.4");
+    return response;
+}
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics_controller.hpp
+ * @brief Prometheus endpoint
+ **/
+
+#pragma once
+
+#include <memory>
+
+#include <oatpp/macro/codegen.hpp>
+#include <oatpp/macro/component.hpp>
+#include <oatpp/web/server/api/ApiController.hpp>
+
+#include "metrics/server_metrics.hpp"
+
+#include OATPP_CODEGEN_BEGIN(ApiController)  //<-- Begin Codegen
+
+/**
+ * Serves the server metrics in the Prometheus text format.
+ */
+class MetricsController: public oatpp::web::server::api::ApiController {
+  public:
+    MetricsController(
+        const std::shared_ptr<ServerMetrics>& metrics,
+        OATPP_COMPONENT(
+            const std::shared_ptr<oatpp::web::mime::ContentMappers>,
+            apiContentMappers
+        )
+    );
+
+  public:
+    ENDPOINT("GET", "/metrics", get_metrics);
+
+  private:
+    std::shared_ptr<ServerMetrics> m_metrics;
+};
+
+#include OATPP_CODEGEN_END(ApiController)  //<-- End Codegen
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file model_info_cache.cpp
+ * @brief ModelInfoCache implementation
+ **/
+
+#include "controller/model_info_cache.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "metrics/server_metrics.hpp"
+#include "utils/sha256.hpp"
+#include "utils/split.hpp"
+
+namespace {
+constexpr size_t etag_digest_length = 16;
+
+std::string_view trim(std::string_view value) {
+    const auto begin = value.find_first_not_of(" \t");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    const auto end = value.find_last_not_of(" \t");
+    return value.substr(begin, end - begin + 1);
+}
+}  // namespace
+
+ModelInfoCache::ModelInfoCache(std::shared_ptr<ServerMetrics> metrics) :
+    m_state(),
+    m_metrics(std::move(metrics)) {}
+
+std::optional<CachedModelInfo> ModelInfoCache::get_info(
+    const std::string& model_name,
+    const InfoLoader& loader
+) {
+    uint64_t generation = 0;
+    {
+        auto state = m_state.lock();
+        const auto it = state->models.find(model_name);
+        if (it != state->models.end()) {
+            record_lookup(ServerMetrics::Cache::MODEL_INFO, true);
+            return it->second;
+        }
+        generation = state->generation;
+    }
+    record_lookup(ServerMetrics::Cache::MODEL_INFO, false);
+
+    // load without holding the lock - the loader touches the filesystem
+    auto info = loader();
+
+    auto state = m_state.lock();
+    // don't store results which may predate an invalidation
+    if (state->generation == generation) {
+        state->models.emplace(model_name, info);
+    }
+    return info;
+}
+
+SerializedBody ModelInfoCache::get_tags(const BodyBuilder& builder) {
+    uint64_t generation = 0;
+    {
+        auto state = m_state.lock();
+        if (state->tags) {
+            record_lookup(ServerMetrics::Cache::TAGS, true);
+            return *state->tags;
+        }
+        generation = state->generation;
+    }
+    record_lookup(ServerMetrics::Cache::TAGS, false);
+
+    auto body = builder();
+    SHA256Hasher hasher;
+    hasher.update(body);
+    auto etag = "\"" + hasher.finalize().substr(0, etag_digest_length) + "\"";
+    SerializedBody result {std::move(body), std::move(etag)};
+
+    auto state = m_state.lock();
+    if (state->generation == generation) {
+        state->tags = result;
+    }
+    return result;
+}
+
+void ModelInfoCache::invalidate() {
+    auto state = m_state.lock();
+    ++state->generation;
+    state->models.clear();
+    state->tags.reset();
+}
+
+void ModelInfoCache::sync(uint64_t store_version) {
+    auto state = m_state.lock();
+    if (state->store_version == store_version) {
+        return;
+    }
+    state->store_version = store_version;
+    ++state->generation;
+    state->models.clear();
+    state->tags.reset();
+}
+
+void ModelInfoCache::record_lookup(ServerMetrics::Cache cache, bool hit) {
+    if (m_metrics) {
+        m_metrics->cache_lookup(cache, hit);
+    }
+}
+
+bool ModelInfoCache::etag_matches(
+    const std::string& if_none_match,
+    const std::string& etag
+) {
+    for (auto candidate : SplitRange(if_none_match, ",")) {
+        candidate = trim(candidate);
+        if (candidate == "*") {
+            return true;
+        }
+        // weak comparison is what If-None-Match requires
+        if (candidate.rfind("W/", 0) == 0) {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == etag) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file model_info_cache.hpp
+ * @brief Cache for model metadata served by /api/tags, /api/ps and /api/show
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <libguarded/cs_plain_guarded.h>
+
+#include "dto/DTOs.hpp"
+#include "metrics/server_metrics.hpp"
+
+struct CachedModelInfo {
+    uint64_t size;
+    std::string modified_at;
+    // shared between responses -> must never be modified after creation
+    oatpp::Object<ModelInfoDetails> details;
+};
+
+struct SerializedBody {
+    std::string body;
+    std::string etag;
+};
+
+/**
+ * Keeps the result of the filesystem stats and details parsing per model, and
+ * the serialized /api/tags body. Everything is dropped on invalidate(), which
+ * must be called whenever a blob is added or removed, and whenever sync() sees
+ * a new model store version.
+ */
+class ModelInfoCache {
+  public:
+    using InfoLoader = std::function<std::optional<CachedModelInfo>()>;
+    using BodyBuilder = std::function<std::string()>;
+
+    explicit ModelInfoCache(std::shared_ptr<ServerMetrics> metrics = nullptr);
+
+    std::optional<CachedModelInfo>
+    get_info(const std::string& model_name, const InfoLoader& loader);
+    SerializedBody get_tags(const BodyBuilder& builder);
+
+    void invalidate();
+    void sync(uint64_t store_version);
+
+    static bool
+    etag_matches(const std::string& if_none_match, const std::string& etag);
+
+  private:
+    void record_lookup(ServerMetrics::Cache cache, bool hit);
+
+  private:
+    struct State {
+        uint64_t generation = 0;
+        uint64_t store_version = 0;
+        // nullopt is cached too - a missing blob stays missing until a pull
+        std::map<std::string, std::optional<CachedModelInfo>> models;
+        std::optional<SerializedBody> tags;
+    };
+
+    libguarded::plain_guarded<State> m_state;
+    std::shared_ptr<ServerMetrics> m_metrics;
+};
@@ -9,26 +9,25 @@
 
 #include "controller/pull_callback.hpp"
 
-#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <string>
-#include <thread>
 
 #include <oatpp/data/mapping/ObjectMapper.hpp>
 #include <oatpp/data/stream/Stream.hpp>
 
+#include "config/static_config.hpp"
+#include "download/progress_channel.hpp"
 #include "dto/DTOs.hpp"
 #include "oatpp/Types.hpp"
 
 PullReadCallback::PullReadCallback(
     const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& object_mapper,
-    const std::shared_ptr<EventQueue>& queue,
-    std::thread&& download_thread
+    const std::shared_ptr<PullProgressChannel>& channel
 ) :
     m_object_mapper(object_mapper),
-    m_queue(queue),
-    m_download_thread(std::move(download_thread)) {}
+    m_channel(channel) {}
 
 oatpp::v_io_size PullReadCallback::read(
     void* buffer,
@@ -37,54 +36,35 @@ oatpp::v_io_size PullReadCallback::read(
 ) {
     (void)action;
 
-    oatpp::v_io_size result_size = 0;
-    m_queue->appendListener(
-        PullEvent::DONE,
-        [this, &result_size](
-            const std::string&,
-            const std::string&,
-            int64_t,
-            int64_t
-        ) {
-            m_download_thread.join();
-            result_size = 0;
-        }
-    );
-    m_queue->appendListener(
-        PullEvent::PROGRESS,
-        [this, buffer, &result_size, bufferSize](
-            const std::string& status,
-            const std::string& digest,
-            int64_t total,
-            int64_t completed
-        ) {
-            auto response = PullResponse::createShared();
-            response->status = status;
-            if (!digest.empty()) {
-                response->digest = digest;
-            }
-            if (total >= 0) {
-                response->total = total;
-            }
-            if (completed >= 0) {
-                response->completed = completed;
-            }
-            const auto result =
-                m_object_mapper->writeToString(response).getValue("") + "\r\n";
-            if (result.size() > bufferSize) {
-                throw std::runtime_error("Buffer too small");
-            }
-            std::memcpy(buffer, result.data(), result.size());
-            result_size = result.size();
-        }
-    );
-
-    while (true) {
-        m_queue->wait();
-        if (m_queue->processOne()) {
-            break;
-        }
+    const auto message =
+        m_channel->wait_next(config::pull_progress_heartbeat);
+    if (!message) {
+        return 0;
     }
 
-    return result_size;
+    auto response = PullResponse::createShared();
+    if (!message->error.empty()) {
+        response->error = message->error;
+    } else {
+        response->status = message->status;
+    }
+    if (!message->digest.empty()) {
+        response->digest = message->digest;
+    }
+    if (message->total >= 0) {
+        response->total = message->total;
+    }
+    if (message->completed >= 0) {
+        response->completed = message->completed;
+    }
+    if (message->bytes_per_second >= 0) {
+        response->bytes_per_second = message->bytes_per_second;
+    }
+    const auto result =
+        m_object_mapper->writeToString(response).getValue("") + "\r\n";
+    if (static_cast<v_buff_size>(result.size()) > bufferSize) {
+        throw std::runtime_error("Buffer too small");
+    }
+    std::memcpy(buffer, result.data(), result.size());
+    return result.size();
 }
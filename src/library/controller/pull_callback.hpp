@@ -9,39 +9,23 @@
 
 #pragma once
 
-#include <cstdint>
-#include <cstring>
 #include <memory>
-#include <string>
-#include <thread>
 
-#include <eventpp/eventqueue.h>
 #include <oatpp/data/mapping/ObjectMapper.hpp>
 #include <oatpp/data/stream/Stream.hpp>
 
-#include "dto/DTOs.hpp"
-
-enum class PullEvent { DONE, PROGRESS };
-
-struct PullResponseData {};
+#include "download/progress_channel.hpp"
 
+/**
+ * Streams the progress of a pull as ndjson lines. The pull runs on a thread
+ * of the PullRegistry, so it finishes for other pulls if the client goes away.
+ */
 class PullReadCallback: public oatpp::data::stream::ReadCallback {
-  public:
-    using EventQueue = eventpp::EventQueue<
-        PullEvent,
-        void(
-            const std::string& status,
-            const std::string& digest,
-            int64_t total,
-            int64_t completed
-        )>;
-
   public:
     PullReadCallback(
         const std::shared_ptr<oatpp::data::mapping::ObjectMapper>&
             object_mapper,
-        const std::shared_ptr<EventQueue>& queue,
-        std::thread&& download_thread
+        const std::shared_ptr<PullProgressChannel>& channel
     );
 
     oatpp::v_io_size read(
@@ -52,6 +36,5 @@ class PullReadCallback: public oatpp::data::stream::ReadCallback {
 
   private:
     std::shared_ptr<oatpp::data::mapping::ObjectMapper> m_object_mapper;
-    std::shared_ptr<EventQueue> m_queue;
-    std::thread m_download_thread;
+    std::shared_ptr<PullProgressChannel> m_channel;
 };
@@ -0,0 +1,123 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file pull_registry.cpp
+ * @brief PullRegistry implementation
+ **/
+
+#include "controller/pull_registry.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <oatpp/base/Log.hpp>
+
+#include "download/throttle.hpp"
+
+PullRegistry::PullRegistry() : m_next_id(0), m_stopped(false) {}
+
+PullRegistry::~PullRegistry() {
+    stop();
+}
+
+void PullRegistry::run(const Pull& pull) {
+    const auto throttle = enter();
+    try {
+        pull(throttle);
+    } catch (...) {
+        leave(throttle);
+        throw;
+    }
+    leave(throttle);
+}
+
+void PullRegistry::start(Pull pull) {
+    auto throttle = enter();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    reap();
+    const auto id = m_next_id++;
+    // the thread marks itself finished only after this lock is released
+    m_threads.emplace(
+        id,
+        std::thread([this, id, throttle, pull = std::move(pull)]() {
+            try {
+                pull(throttle);
+            } catch (const std::exception& e) {
+                OATPP_LOGe("PullRegistry", "pull failed: {}", e.what());
+            }
+            leave(throttle);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finished.push_back(id);
+        })
+    );
+}
+
+size_t PullRegistry::active() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running.size();
+}
+
+bool PullRegistry::wait_idle(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_idle.wait_until(lock, deadline, [this]() {
+        return m_running.empty();
+    });
+}
+
+void PullRegistry::stop() {
+    std::map<uint64_t, std::thread> threads;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stopped = true;
+        for (const auto& throttle : m_running) {
+            throttle->cancel();
+        }
+        threads.swap(m_threads);
+        m_finished.clear();
+    }
+    for (auto& [id, thread] : threads) {
+        (void)id;
+        thread.join();
+    }
+    // the pulls which run on HTTP workers
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_running.empty(); });
+}
+
+std::shared_ptr<DownloadThrottle> PullRegistry::enter() {
+    auto throttle = std::make_shared<DownloadThrottle>(0, nullptr);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stopped) {
+        throw std::runtime_error("the server is shutting down");
+    }
+    m_running.insert(throttle);
+    return throttle;
+}
+
+void PullRegistry::leave(const std::shared_ptr<DownloadThrottle>& throttle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running.erase(throttle);
+    if (m_running.empty()) {
+        m_idle.notify_all();
+    }
+}
+
+void PullRegistry::reap() {
+    for (const auto id : m_finished) {
+        const auto thread = m_threads.find(id);
+        if (thread != m_threads.end()) {
+            thread->second.join();
+            m_threads.erase(thread);
+        }
+    }
+    m_finished.clear();
+}
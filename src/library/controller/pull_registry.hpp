@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file pull_registry.hpp
+ * @brief The pulls requested by clients, stopped at shutdown
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "download/throttle.hpp"
+
+/**
+ * Counts the pulls and imports in progress and owns the threads of the
+ * streamed ones, so none of them outlives the server. Each pull gets an
+ * unlimited throttle to pass in its PullOptions - stop() cancels the
+ * downloads through it and waits for the pulls to return.
+ */
+class PullRegistry {
+  public:
+    using Pull = std::function<void(const std::shared_ptr<DownloadThrottle>&)>;
+
+    PullRegistry();
+    ~PullRegistry();
+
+    PullRegistry(const PullRegistry&) = delete;
+    PullRegistry& operator=(const PullRegistry&) = delete;
+
+    // run the pull on the calling thread and on a thread of the registry;
+    // both throw std::runtime_error once stopped
+    void run(const Pull& pull);
+    void start(Pull pull);
+    size_t active() const;
+    // false if pulls were still running at the deadline
+    bool wait_idle(std::chrono::steady_clock::time_point deadline);
+    void stop();
+
+  private:
+    std::shared_ptr<DownloadThrottle> enter();
+    void leave(const std::shared_ptr<DownloadThrottle>& throttle);
+    // joins the threads of finished pulls, with m_mutex held
+    void reap();
+
+  private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_idle;
+    std::set<std::shared_ptr<DownloadThrottle>> m_running;
+    std::map<uint64_t, std::thread> m_threads;
+    std::vector<uint64_t> m_finished;
+    uint64_t m_next_id;
+    bool m_stopped;
+};
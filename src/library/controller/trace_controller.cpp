@@ -0,0 +1,31 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file trace_controller.cpp
+ * @brief TraceController implementation
+ **/
+
+#include "controller/trace_controller.hpp"
+
+#include <memory>
+
+#include <oatpp/web/server/api/ApiController.hpp>
+
+#include "tracing/tracer.hpp"
+
+TraceController::TraceController(
+    const std::shared_ptr<oatpp::web::mime::ContentMappers>& apiContentMappers
+) :
+    oatpp::web::server::api::ApiController(apiContentMappers) {}
+
+std::shared_ptr<oatpp::web::protocol::http::outgoing::Response>
+TraceController::get_trace() {
+    auto response = createResponse(
+        Status::CODE_200,
+        tracing::Tracer::instance().chrome_trace()
+    );
+    response->putHeader("Content-Type", "application/json");
+    return response;
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file trace_controller.hpp
+ * @brief Debug endpoint for the request trace
+ **/
+
+#pragma once
+
+#include <memory>
+
+#include <oatpp/macro/codegen.hpp>
+#include <oatpp/macro/component.hpp>
+#include <oatpp/web/server/api/ApiController.hpp>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)  //<-- Begin Codegen
+
+/**
+ * Serves the buffered spans as a Chrome trace, to be opened in Perfetto.
+ */
+class TraceController: public oatpp::web::server::api::ApiController {
+  public:
+    explicit TraceController(
+        OATPP_COMPONENT(
+            const std::shared_ptr<oatpp::web::mime::ContentMappers>,
+            apiContentMappers
+        )
+    );
+
+  public:
+    ENDPOINT("GET", "/hailo/v1/debug/trace", get_trace);
+};
+
+#include OATPP_CODEGEN_END(ApiController)  //<-- End Codegen
@@ -9,46 +9,62 @@
 
 #include "controller/writefile_callback.hpp"
 
+#include <cstdint>
 #include <string>
+#include <utility>
 
-#include <oatpp/data/stream/FileStream.hpp>
+#include <oatpp/data/stream/Stream.hpp>
 
-#include "config/static_config.hpp"
-#include "controller/pull_callback.hpp"
+#include "download/blob_file_writer.hpp"
+#include "download/in_flight.hpp"
+#include "download/stall_detector.hpp"
+#include "utils/sha256.hpp"
 
 OutputFileStream::OutputFileStream(
-    const char* filename,
+    const std::string& filename,
     std::string resource,
-    const std::shared_ptr<PullReadCallback::EventQueue>& queue,
-    const std::string& content_length
+    const std::shared_ptr<InFlightDownload>& download,
+    int64_t offset,
+    int64_t total,
+    SHA256Hasher&& hasher,
+    const DownloadConfig& config
 ) :
-    oatpp::data::stream::FileOutputStream(filename),
+    m_file(filename, offset, offset == 0, config.direct_io),
     m_resource(std::move(resource)),
-    m_queue(queue),
-    m_content_length(std::stoll(content_length)),
-    m_completed(0),
-    m_update_every(config::output_file_stream_update_every),
-    m_count(0) {}
+    m_download(download),
+    m_total(total),
+    m_completed(offset),
+    m_hasher(std::move(hasher)),
+    m_stall_detector(config) {
+    if (m_total > 0) {
+        m_file.reserve(m_total);
+    }
+}
 
 oatpp::v_io_size OutputFileStream::write(
     const void* data,
     v_buff_size count,
     oatpp::async::Action& action
 ) {
-    auto result =
-        oatpp::data::stream::FileOutputStream::write(data, count, action);
-    m_completed += result;
-    m_count += 1;
-    if (m_count % m_update_every != 0) {
-        return result;
-    }
-    m_queue->enqueue(
-        PullEvent::PROGRESS,
-        "pulling",
-        m_resource,
-        m_content_length,
-        m_completed
-    );
-
-    return result;
+    (void)action;
+    m_file.write(data, count);
+    m_hasher.update(static_cast<const char*>(data), count);
+    m_completed += count;
+    // coalesced by the progress channels
+    m_download->progress(m_resource, m_total, m_completed);
+    m_stall_detector.exclude(m_download->throttle(count));
+    m_stall_detector.update(count);
+    return count;
+}
+
+int64_t OutputFileStream::completed() const {
+    return m_completed;
+}
+
+void OutputFileStream::close() {
+    m_file.close();
+}
+
+std::string OutputFileStream::finalize_digest() {
+    return m_hasher.finalize();
 }
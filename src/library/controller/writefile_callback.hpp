@@ -13,17 +13,33 @@
 #include <memory>
 #include <string>
 
-#include <oatpp/data/stream/FileStream.hpp>
+#include <oatpp/data/stream/Stream.hpp>
 
-#include "controller/pull_callback.hpp"
+#include "download/blob_file_writer.hpp"
+#include "download/in_flight.hpp"
+#include "download/stall_detector.hpp"
+#include "utils/sha256.hpp"
 
-class OutputFileStream: public oatpp::data::stream::FileOutputStream {
+/**
+ * Writes the downloaded blob to a file while hashing it, so the digest is
+ * known as soon as the transfer is done. The data goes through a
+ * BlobFileWriter, so it must be closed before the file is used. Progress is
+ * published to everyone waiting for the download. A transfer which gets too
+ * slow is aborted with DownloadStalled.
+ *
+ * A non-zero offset appends to an existing partial file; the hasher must
+ * already contain those first offset bytes.
+ */
+class OutputFileStream: public oatpp::data::stream::WriteCallback {
   public:
     OutputFileStream(
-        const char* filename,
+        const std::string& filename,
         std::string resource,
-        const std::shared_ptr<PullReadCallback::EventQueue>& queue,
-        const std::string& content_length
+        const std::shared_ptr<InFlightDownload>& download,
+        int64_t offset,
+        int64_t total,
+        SHA256Hasher&& hasher,
+        const DownloadConfig& config
     );
 
     oatpp::v_io_size write(
@@ -32,11 +48,21 @@ class OutputFileStream: public oatpp::data::stream::FileOutputStream {
         oatpp::async::Action& action
     ) override;
 
+    // bytes in the file, including the resumed offset
+    int64_t completed() const;
+
+    // writes the buffered data, must be called before the file is used
+    void close();
+
+    // sha256 of everything written so far, may be called once
+    std::string finalize_digest();
+
   private:
-    std::shared_ptr<PullReadCallback::EventQueue> m_queue;
+    BlobFileWriter m_file;
     std::string m_resource;
-    int64_t m_content_length;
+    std::shared_ptr<InFlightDownload> m_download;
+    int64_t m_total;
     int64_t m_completed;
-    int_fast32_t m_update_every;
-    int_fast32_t m_count;
+    SHA256Hasher m_hasher;
+    StallDetector m_stall_detector;
 };
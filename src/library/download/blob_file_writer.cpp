@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file blob_file_writer.cpp
+ * @brief BlobFileWriter implementation
+ **/
+
+#include "download/blob_file_writer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <system_error>
+
+#include <oatpp/base/Log.hpp>
+
+#include "config/static_config.hpp"
+
+namespace {
+void* allocate_buffer() {
+    void* buffer = nullptr;
+    if (posix_memalign(
+            &buffer,
+            config::blob_write_alignment,
+            config::blob_write_buffer_size
+        )
+        != 0) {
+        throw std::bad_alloc();
+    }
+    return buffer;
+}
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+}  // namespace
+
+BlobFileWriter::BlobFileWriter(
+    const std::string& path,
+    int64_t offset,
+    bool truncate,
+    bool direct_io
+) :
+    m_path(path),
+    m_fd(-1),
+    // direct I/O needs the file position to be aligned
+    m_direct_io(direct_io && offset % config::blob_write_alignment == 0),
+    m_buffer(static_cast<char*>(allocate_buffer()), std::free),
+    m_buffered(0),
+    m_offset(offset),
+    m_released(offset) {
+    const auto flags = O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0);
+    if (m_direct_io) {
+        m_fd = open(path.c_str(), flags | O_DIRECT, 0644);
+        if (m_fd < 0 && errno == EINVAL) {
+            // not supported by the filesystem, e.g. tmpfs
+            OATPP_LOGi(
+                "BlobFileWriter",
+                "direct I/O not supported for {}",
+                path
+            );
+            m_direct_io = false;
+        }
+    }
+    if (m_fd < 0) {
+        m_fd = open(path.c_str(), flags, 0644);
+    }
+    if (m_fd < 0) {
+        throw_errno("Failed to open " + path);
+    }
+}
+
+BlobFileWriter::~BlobFileWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        OATPP_LOGe(
+            "BlobFileWriter",
+            "failed to close {}: {}",
+            m_path,
+            e.what()
+        );
+        (void)::close(m_fd);
+    }
+}
+
+void BlobFileWriter::reserve(int64_t size) {
+    if (size <= m_offset) {
+        return;
+    }
+    // best effort, not every filesystem supports it
+    (void)fallocate(m_fd, FALLOC_FL_KEEP_SIZE, m_offset, size - m_offset);
+}
+
+void BlobFileWriter::write(const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const auto count =
+            std::min(size, config::blob_write_buffer_size - m_buffered);
+        std::memcpy(m_buffer.get() + m_buffered, bytes, count);
+        m_buffered += count;
+        bytes += count;
+        size -= count;
+        if (m_buffered == config::blob_write_buffer_size) {
+            write_buffer();
+        }
+    }
+}
+
+void BlobFileWriter::close() {
+    if (m_fd < 0) {
+        return;
+    }
+    if (m_buffered > 0) {
+        if (m_direct_io) {
+            // the tail isn't a whole number of blocks
+            if (fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) & ~O_DIRECT) != 0) {
+                throw_errno("Failed to disable direct I/O for " + m_path);
+            }
+            m_direct_io = false;
+        }
+        write_buffer();
+    }
+    release_written(m_offset);
+    const auto fd = m_fd;
+    m_fd = -1;
+    if (::close(fd) != 0) {
+        throw_errno("Failed to close " + m_path);
+    }
+}
+
+int64_t BlobFileWriter::position() const {
+    return m_offset + m_buffered;
+}
+
+void BlobFileWriter::write_buffer() {
+    const auto size = m_buffered;
+    size_t done = 0;
+    while (done < size) {
+        const auto result =
+            pwrite(m_fd, m_buffer.get() + done, size - done, m_offset + done);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("Failed to write " + m_path);
+        }
+        done += result;
+    }
+    m_offset += size;
+    m_buffered = 0;
+
+    if (!m_direct_io) {
+        // start the write-back now, it's waited for on the next buffer
+        (void)sync_file_range(
+            m_fd,
+            m_offset - size,
+            size,
+            SYNC_FILE_RANGE_WRITE
+        );
+        release_written(m_offset - size);
+    }
+}
+
+void BlobFileWriter::release_written(int64_t end) {
+    if (m_direct_io || end <= m_released) {
+        return;
+    }
+    const auto length = end - m_released;
+    (void)sync_file_range(
+        m_fd,
+        m_released,
+        length,
+        SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE
+            | SYNC_FILE_RANGE_WAIT_AFTER
+    );
+    (void)posix_fadvise(m_fd, m_released, length, POSIX_FADV_DONTNEED);
+    m_released = end;
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file blob_file_writer.hpp
+ * @brief Writing downloaded blobs to disk in large blocks
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Collects the data into a large aligned buffer and writes whole buffers at
+ * their position in the file. With direct I/O the page cache isn't used at
+ * all; otherwise written ranges are flushed and dropped from the page cache
+ * as the download goes, so a multi-GB blob doesn't evict the pages of the
+ * running model and server.
+ */
+class BlobFileWriter {
+  public:
+    // writes from offset onwards; the file is created if it doesn't exist
+    BlobFileWriter(
+        const std::string& path,
+        int64_t offset,
+        bool truncate,
+        bool direct_io
+    );
+    ~BlobFileWriter();
+
+    BlobFileWriter(const BlobFileWriter&) = delete;
+    BlobFileWriter& operator=(const BlobFileWriter&) = delete;
+
+    // allocates the disk space up to size without changing the file size,
+    // so an interrupted download still resumes from the data written
+    void reserve(int64_t size);
+    void write(const void* data, size_t size);
+    // writes the buffered tail, may be called more than once
+    void close();
+
+    // the position after the last byte written
+    int64_t position() const;
+
+  private:
+    void write_buffer();
+    void release_written(int64_t end);
+
+  private:
+    std::string m_path;
+    int m_fd;
+    bool m_direct_io;
+    std::unique_ptr<char, void (*)(void*)> m_buffer;
+    size_t m_buffered;
+    // file position of the buffer start
+    int64_t m_offset;
+    // everything before this is written back and dropped from the cache
+    int64_t m_released;
+};
@@ -9,9 +9,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include <oatpp/Types.hpp>
 #include <oatpp/macro/codegen.hpp>
 #include <oatpp/web/client/ApiClient.hpp>
+#include <oatpp/web/protocol/http/incoming/Response.hpp>
 
 /* Begin Api Client code generation */
 #include OATPP_CODEGEN_BEGIN(ApiClient)
@@ -24,7 +27,44 @@ class DownloadClient: public oatpp::web::client::ApiClient {
     API_CLIENT_INIT(DownloadClient)
 
     API_CALL("GET", "blob/{digest}", getDownload, PATH(String, digest))
+    API_CALL(
+        "GET",
+        "blob/{digest}",
+        getDownloadRange,
+        PATH(String, digest),
+        HEADER(String, range, "Range")
+    )
+
+    // blobs served by another hailo-ollama node
+    API_CALL(
+        "GET",
+        "hailo/v1/blob/{digest}",
+        getPeerDownload,
+        PATH(String, digest)
+    )
+    API_CALL(
+        "GET",
+        "hailo/v1/blob/{digest}",
+        getPeerDownloadRange,
+        PATH(String, digest),
+        HEADER(String, range, "Range")
+    )
 };
 
 /* End Api Client code generation */
 #include OATPP_CODEGEN_END(ApiClient)
+
+/**
+ * Drops a response whose body won't be read to the end. The data left on its
+ * connection would be taken as the next response, so the connection must not
+ * go back to the connection pool.
+ */
+inline void discard_response(
+    const std::shared_ptr<oatpp::web::protocol::http::incoming::Response>&
+        response
+) {
+    const auto connection = response->getConnection();
+    if (connection.object && connection.invalidator) {
+        connection.invalidator->invalidate(connection.object);
+    }
+}
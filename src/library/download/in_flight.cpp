@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file in_flight.cpp
+ * @brief InFlightDownload implementation
+ **/
+
+#include "download/in_flight.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "download/progress_channel.hpp"
+#include "download/throttle.hpp"
+
+namespace {
+std::string error_message(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "unknown error";
+    }
+}
+}  // namespace
+
+InFlightDownload::InFlightDownload(
+    std::shared_ptr<DownloadThrottle> throttle
+) :
+    m_finished(false),
+    m_throttle(std::move(throttle)),
+    m_received(0) {}
+
+void InFlightDownload::subscribe(
+    const std::shared_ptr<PullProgressChannel>& channel
+) {
+    if (!channel) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) {
+        send_result(*channel);
+        return;
+    }
+    if (m_last_status) {
+        channel->status(*m_last_status);
+    }
+    if (m_last_progress) {
+        channel->progress(
+            m_last_progress->digest,
+            m_last_progress->total,
+            m_last_progress->completed
+        );
+    }
+    m_subscribers.push_back(channel);
+}
+
+void InFlightDownload::status(const std::string& status) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_last_status = status;
+    m_last_progress.reset();
+    for (const auto& channel : m_subscribers) {
+        channel->status(status);
+    }
+}
+
+void InFlightDownload::progress(
+    const std::string& digest,
+    int64_t total,
+    int64_t completed
+) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PullProgress progress;
+    progress.digest = digest;
+    progress.total = total;
+    progress.completed = completed;
+    m_last_progress = std::move(progress);
+    for (const auto& channel : m_subscribers) {
+        channel->progress(digest, total, completed);
+    }
+}
+
+void InFlightDownload::finish(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished = true;
+    m_error = std::move(error);
+    if (m_error) {
+        m_error_message = error_message(m_error);
+    }
+    for (const auto& channel : m_subscribers) {
+        send_result(*channel);
+    }
+    m_subscribers.clear();
+    m_finished_cv.notify_all();
+}
+
+void InFlightDownload::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished_cv.wait(lock, [this]() { return m_finished; });
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+std::chrono::steady_clock::duration
+InFlightDownload::throttle(int64_t bytes) {
+    m_received.fetch_add(bytes, std::memory_order_relaxed);
+    if (!m_throttle) {
+        return {};
+    }
+    return m_throttle->consume(bytes);
+}
+
+void InFlightDownload::release_throttle() {
+    if (m_throttle) {
+        m_throttle->release();
+    }
+}
+
+int64_t InFlightDownload::received() const {
+    return m_received.load(std::memory_order_relaxed);
+}
+
+void InFlightDownload::send_result(PullProgressChannel& channel) const {
+    if (m_error) {
+        channel.error(m_error_message);
+    } else {
+        channel.status("success");
+    }
+    channel.done();
+}
+
+std::pair<std::shared_ptr<InFlightDownload>, bool>
+InFlightDownloads::join(
+    const std::string& digest,
+    std::shared_ptr<DownloadThrottle> throttle
+) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_downloads.find(digest);
+    if (it != m_downloads.end()) {
+        return {it->second, false};
+    }
+    auto download = std::make_shared<InFlightDownload>(std::move(throttle));
+    m_downloads.emplace(digest, download);
+    return {std::move(download), true};
+}
+
+void InFlightDownloads::remove(const std::string& digest) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_downloads.erase(digest);
+}
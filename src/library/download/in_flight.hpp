@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file in_flight.hpp
+ * @brief Sharing a blob download between concurrent pulls
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "download/progress_channel.hpp"
+#include "download/throttle.hpp"
+
+/**
+ * A single download with any number of subscribed pulls. Every subscriber gets
+ * the progress on its own channel, and the final result through wait().
+ */
+class InFlightDownload {
+  public:
+    // a background download is limited by the throttle until released
+    explicit InFlightDownload(
+        std::shared_ptr<DownloadThrottle> throttle = nullptr
+    );
+
+    // a null channel only waits for the result
+    void subscribe(const std::shared_ptr<PullProgressChannel>& channel);
+    void status(const std::string& status);
+    void progress(const std::string& digest, int64_t total, int64_t completed);
+    // sends the result to all subscribers and wakes up wait()
+    void finish(std::exception_ptr error);
+    // rethrows the error the download failed with
+    void wait();
+    // called by the writers, returns the time they were held back
+    std::chrono::steady_clock::duration throttle(int64_t bytes);
+    // a foreground pull joined -> no more limits
+    void release_throttle();
+    // bytes passed to throttle(), including the ones of failed attempts
+    int64_t received() const;
+
+  private:
+    void send_result(PullProgressChannel& channel) const;
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_finished_cv;
+    std::vector<std::shared_ptr<PullProgressChannel>> m_subscribers;
+    // replayed to late subscribers
+    std::optional<std::string> m_last_status;
+    std::optional<PullProgress> m_last_progress;
+    bool m_finished;
+    std::exception_ptr m_error;
+    std::string m_error_message;
+    const std::shared_ptr<DownloadThrottle> m_throttle;
+    std::atomic<int64_t> m_received;
+};
+
+/**
+ * Downloads in progress by digest
+ */
+class InFlightDownloads {
+  public:
+    // the returned flag is true if the caller must run the download; the
+    // throttle only applies to a download the call starts
+    std::pair<std::shared_ptr<InFlightDownload>, bool> join(
+        const std::string& digest,
+        std::shared_ptr<DownloadThrottle> throttle = nullptr
+    );
+    void remove(const std::string& digest);
+
+  private:
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<InFlightDownload>> m_downloads;
+};
@@ -0,0 +1,300 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file keepalive_connection_provider.cpp
+ * @brief KeepAliveConnectionProvider implementation
+ **/
+
+#include "download/keepalive_connection_provider.hpp"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <oatpp/base/Log.hpp>
+#include <oatpp/data/stream/Stream.hpp>
+#include <oatpp/network/tcp/Connection.hpp>
+#include <oatpp/provider/Invalidator.hpp>
+
+#include "config/static_config.hpp"
+
+namespace {
+using oatpp::data::stream::IOMode;
+using oatpp::data::stream::IOStream;
+using Connection = oatpp::provider::ResourceHandle<IOStream>;
+
+// oatpp retries a read which timed out, even on a blocking connection ->
+// it is failed here, so the download fails over to the next mirror
+class ReceiveTimeoutStream: public IOStream {
+  public:
+    explicit ReceiveTimeoutStream(Connection connection) :
+        m_connection(std::move(connection)) {}
+
+    oatpp::v_io_size write(
+        const void* data,
+        v_buff_size count,
+        oatpp::async::Action& action
+    ) override {
+        return m_connection.object->write(data, count, action);
+    }
+
+    oatpp::v_io_size
+    read(void* buffer, v_buff_size count, oatpp::async::Action& action)
+        override {
+        const auto result = m_connection.object->read(buffer, count, action);
+        const auto timed_out = errno == EAGAIN || errno == EWOULDBLOCK;
+        if (result == oatpp::IOError::RETRY_READ && timed_out
+            && getInputStreamIOMode() == IOMode::BLOCKING) {
+            OATPP_LOGw(
+                "KeepAliveConnectionProvider",
+                "no data received within the timeout, closing"
+            );
+            return oatpp::IOError::BROKEN_PIPE;
+        }
+        return result;
+    }
+
+    void setOutputStreamIOMode(IOMode mode) override {
+        m_connection.object->setOutputStreamIOMode(mode);
+    }
+    IOMode getOutputStreamIOMode() override {
+        return m_connection.object->getOutputStreamIOMode();
+    }
+    oatpp::data::stream::Context& getOutputStreamContext() override {
+        return m_connection.object->getOutputStreamContext();
+    }
+    void setInputStreamIOMode(IOMode mode) override {
+        m_connection.object->setInputStreamIOMode(mode);
+    }
+    IOMode getInputStreamIOMode() override {
+        return m_connection.object->getInputStreamIOMode();
+    }
+    oatpp::data::stream::Context& getInputStreamContext() override {
+        return m_connection.object->getInputStreamContext();
+    }
+
+    const Connection& connection() const {
+        return m_connection;
+    }
+
+  private:
+    Connection m_connection;
+};
+
+// hands the wrapped connection back to the tcp provider
+class ReceiveTimeoutInvalidator:
+    public oatpp::provider::Invalidator<IOStream> {
+  public:
+    void invalidate(const std::shared_ptr<IOStream>& stream) override {
+        const auto& connection =
+            std::static_pointer_cast<ReceiveTimeoutStream>(stream)
+                ->connection();
+        connection.invalidator->invalidate(connection.object);
+    }
+};
+
+// shuts the socket down like the invalidator of oatpp's tcp provider, the
+// connection closes it when it's destroyed
+class TcpInvalidator: public oatpp::provider::Invalidator<IOStream> {
+  public:
+    void invalidate(const std::shared_ptr<IOStream>& stream) override {
+        const auto connection =
+            std::static_pointer_cast<oatpp::network::tcp::Connection>(stream);
+        (void)shutdown(connection->getHandle(), SHUT_RDWR);
+    }
+};
+
+// a blocking socket connected within the timeout, trying every address of
+// the host
+oatpp::v_io_handle connect_with_timeout(
+    const std::string& host,
+    uint16_t port,
+    std::chrono::seconds timeout
+) {
+    addrinfo hints {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    const auto resolved = getaddrinfo(
+        host.c_str(),
+        std::to_string(port).c_str(),
+        &hints,
+        &addresses
+    );
+    if (resolved != 0) {
+        throw std::runtime_error(
+            "failed to resolve " + host + ": " + gai_strerror(resolved)
+        );
+    }
+    const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> guard(
+        addresses,
+        freeaddrinfo
+    );
+    const auto timeout_ms = timeout.count() == 0
+        ? -1
+        : static_cast<int>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(timeout)
+                .count()
+        );
+    auto error = ENOENT;
+    for (auto* address = addresses; address != nullptr;
+         address = address->ai_next) {
+        const auto fd = socket(
+            address->ai_family,
+            address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+            address->ai_protocol
+        );
+        if (fd < 0) {
+            error = errno;
+            continue;
+        }
+        error = 0;
+        if (connect(fd, address->ai_addr, address->ai_addrlen) != 0) {
+            error = errno;
+        }
+        if (error == EINPROGRESS) {
+            pollfd writable {fd, POLLOUT, 0};
+            const auto ready = poll(&writable, 1, timeout_ms);
+            if (ready > 0) {
+                socklen_t length = sizeof(error);
+                if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length)
+                    != 0) {
+                    error = errno;
+                }
+            } else {
+                error = ready == 0 ? ETIMEDOUT : errno;
+            }
+        }
+        if (error == 0) {
+            // blocking, like the connections of oatpp's provider
+            (void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+            return fd;
+        }
+        (void)close(fd);
+    }
+    throw std::runtime_error(
+        "failed to connect to " + host + ":" + std::to_string(port) + ": "
+        + std::strerror(error)
+    );
+}
+
+void set_receive_timeout(
+    oatpp::v_io_handle handle,
+    std::chrono::seconds timeout
+) {
+    timeval value {};
+    value.tv_sec = static_cast<time_t>(timeout.count());
+    if (setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, &value, sizeof(value))
+        != 0) {
+        OATPP_LOGw(
+            "KeepAliveConnectionProvider",
+            "failed to set the receive timeout"
+        );
+    }
+}
+
+void enable_keepalive(oatpp::v_io_handle handle) {
+    const int enable = 1;
+    const int idle = config::download_keepalive_idle_s;
+    const int interval = config::download_keepalive_interval_s;
+    const int count = config::download_keepalive_count;
+    if (setsockopt(handle, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable))
+            != 0
+        || setsockopt(handle, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle))
+            != 0
+        || setsockopt(
+               handle,
+               IPPROTO_TCP,
+               TCP_KEEPINTVL,
+               &interval,
+               sizeof(interval)
+           ) != 0
+        || setsockopt(handle, IPPROTO_TCP, TCP_KEEPCNT, &count, sizeof(count))
+            != 0) {
+        OATPP_LOGw("KeepAliveConnectionProvider", "failed to set keep-alive");
+    }
+}
+}  // namespace
+
+KeepAliveConnectionProvider::KeepAliveConnectionProvider(
+    const std::string& host,
+    uint16_t port,
+    std::chrono::seconds receive_timeout,
+    std::chrono::seconds connect_timeout
+) :
+    m_host(host),
+    m_port(port),
+    m_provider(oatpp::network::tcp::client::ConnectionProvider::createShared(
+        {host, port}
+    )),
+    m_receive_timeout(receive_timeout),
+    m_connect_timeout(connect_timeout) {
+    // the TLS provider takes the host name for SNI from its transport
+    for (const auto& property : m_provider->getProperties()) {
+        setProperty(property.first.toString(), property.second.toString());
+    }
+}
+
+std::shared_ptr<KeepAliveConnectionProvider>
+KeepAliveConnectionProvider::createShared(
+    const std::string& host,
+    uint16_t port,
+    std::chrono::seconds receive_timeout,
+    std::chrono::seconds connect_timeout
+) {
+    return std::make_shared<KeepAliveConnectionProvider>(
+        host,
+        port,
+        receive_timeout,
+        connect_timeout
+    );
+}
+
+oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>
+KeepAliveConnectionProvider::get() {
+    static const auto tcp_invalidator = std::make_shared<TcpInvalidator>();
+    const auto handle =
+        connect_with_timeout(m_host, m_port, m_connect_timeout);
+    Connection connection(
+        std::make_shared<oatpp::network::tcp::Connection>(handle),
+        tcp_invalidator
+    );
+    enable_keepalive(handle);
+    if (m_receive_timeout.count() == 0) {
+        return connection;
+    }
+    set_receive_timeout(handle, m_receive_timeout);
+    static const auto invalidator =
+        std::make_shared<ReceiveTimeoutInvalidator>();
+    return Connection(
+        std::make_shared<ReceiveTimeoutStream>(std::move(connection)),
+        invalidator
+    );
+}
+
+oatpp::async::CoroutineStarterForResult<
+    const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&>
+KeepAliveConnectionProvider::getAsync() {
+    // downloads only use the blocking API
+    return m_provider->getAsync();
+}
+
+void KeepAliveConnectionProvider::stop() {
+    m_provider->stop();
+}
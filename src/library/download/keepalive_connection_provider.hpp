@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file keepalive_connection_provider.hpp
+ * @brief TCP client connections with keep-alive probes
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <oatpp/network/ConnectionProvider.hpp>
+#include <oatpp/network/tcp/client/ConnectionProvider.hpp>
+
+/**
+ * Enables TCP keep-alive on the connections of a tcp client provider, so a
+ * blocking read from a mirror which went away fails instead of waiting
+ * forever. A receive timeout covers a mirror which is still there but sends
+ * nothing: a read which gets no data for that long fails like a broken
+ * connection, instead of being retried by oatpp. The connect is bounded as
+ * well, a blocking one waits minutes for a host which doesn't answer. Used
+ * directly for plain HTTP and as the transport under TLS.
+ */
+class KeepAliveConnectionProvider:
+    public oatpp::network::ClientConnectionProvider {
+  public:
+    // zero timeouts wait forever
+    KeepAliveConnectionProvider(
+        const std::string& host,
+        uint16_t port,
+        std::chrono::seconds receive_timeout,
+        std::chrono::seconds connect_timeout
+    );
+
+    static std::shared_ptr<KeepAliveConnectionProvider> createShared(
+        const std::string& host,
+        uint16_t port,
+        std::chrono::seconds receive_timeout,
+        std::chrono::seconds connect_timeout
+    );
+
+    oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>
+    get() override;
+    oatpp::async::CoroutineStarterForResult<
+        const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&>
+    getAsync() override;
+    void stop() override;
+
+  private:
+    std::string m_host;
+    uint16_t m_port;
+    // for the async API and the properties of the address
+    std::shared_ptr<oatpp::network::tcp::client::ConnectionProvider>
+        m_provider;
+    std::chrono::seconds m_receive_timeout;
+    std::chrono::seconds m_connect_timeout;
+};
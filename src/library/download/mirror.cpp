@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file mirror.cpp
+ * @brief Mirror and MirrorSet implementation
+ **/
+
+#include "download/mirror.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <oatpp-openssl/Config.hpp>
+#include <oatpp-openssl/client/ConnectionProvider.hpp>
+#include <oatpp/base/Log.hpp>
+#include <oatpp/json/ObjectMapper.hpp>
+#include <oatpp/network/ConnectionPool.hpp>
+#include <oatpp/web/client/HttpRequestExecutor.hpp>
+
+#include "config/static_config.hpp"
+#include "download/client.hpp"
+#include "download/keepalive_connection_provider.hpp"
+
+namespace {
+using Status = oatpp::web::protocol::http::Status;
+
+// results of the probes, shared with probe threads which may outlive
+// the ranking when a mirror doesn't answer in time - until the probe
+// timeout of their connect or read fails
+struct ProbeResults {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t pending;
+    std::vector<std::optional<std::chrono::steady_clock::duration>> latency;
+};
+
+std::shared_ptr<oatpp::network::ClientConnectionProvider>
+make_connection_provider(
+    const MirrorConfig& config,
+    std::chrono::seconds receive_timeout,
+    std::chrono::seconds connect_timeout
+) {
+    /* create connection provider */
+    auto transport = KeepAliveConnectionProvider::createShared(
+        config.host,
+        config.port,
+        receive_timeout,
+        connect_timeout
+    );
+    if (!config.tls) {
+        return transport;
+    }
+    return oatpp::openssl::client::ConnectionProvider::createShared(
+        oatpp::openssl::Config::createDefaultClientConfigShared(),
+        transport
+    );
+}
+
+std::shared_ptr<DownloadClient> make_client(
+    const std::shared_ptr<oatpp::network::ClientConnectionProvider>& provider
+) {
+    /* create HTTP request executor */
+    auto requestExecutor =
+        oatpp::web::client::HttpRequestExecutor::createShared(provider);
+
+    /* create JSON object mapper */
+    auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+
+    /* create API client */
+    return DownloadClient::createShared(requestExecutor, objectMapper);
+}
+}  // namespace
+
+Mirror::Mirror(
+    const MirrorConfig& config,
+    std::chrono::seconds receive_timeout
+) :
+    m_name(config.host + ":" + std::to_string(config.port)),
+    m_weight(std::max<uint32_t>(config.weight, 1)),
+    m_peer(config.peer) {
+    /* keep connections alive between requests */
+    m_connection_pool = oatpp::network::ClientConnectionPool::createShared(
+        make_connection_provider(
+            config,
+            receive_timeout,
+            config::download_connect_timeout
+        ),
+        config::download_pool_max_connections,
+        config::download_pool_idle_ttl
+    );
+    m_client = make_client(m_connection_pool);
+    // a mirror which doesn't answer doesn't keep a pooled connection
+    const auto probe_timeout =
+        std::chrono::duration_cast<std::chrono::seconds>(
+            config::mirror_probe_timeout
+        );
+    m_probe_client = make_client(
+        make_connection_provider(config, probe_timeout, probe_timeout)
+    );
+}
+
+Mirror::~Mirror() {
+    m_connection_pool->stop();
+}
+
+std::shared_ptr<Mirror::Response>
+Mirror::request(const std::string& source, const std::string& range) {
+    if (m_peer) {
+        if (range.empty()) {
+            return m_client->getPeerDownload(source);
+        }
+        return m_client->getPeerDownloadRange(source, range);
+    }
+    if (range.empty()) {
+        return m_client->getDownload(source);
+    }
+    return m_client->getDownloadRange(source, range);
+}
+
+std::shared_ptr<Mirror::Response> Mirror::probe(const std::string& source) {
+    if (m_peer) {
+        return m_probe_client->getPeerDownloadRange(source, "bytes=0-0");
+    }
+    return m_probe_client->getDownloadRange(source, "bytes=0-0");
+}
+
+const std::string& Mirror::name() const {
+    return m_name;
+}
+
+uint32_t Mirror::weight() const {
+    return m_weight;
+}
+
+MirrorSet::MirrorSet(
+    const std::vector<MirrorConfig>& mirrors,
+    std::chrono::seconds receive_timeout
+) :
+    m_ranked_time(),
+    m_ranking(false) {
+    if (mirrors.empty()) {
+        throw std::invalid_argument("no blob library mirrors configured");
+    }
+    for (const auto& mirror : mirrors) {
+        m_mirrors.push_back(
+            std::make_shared<Mirror>(mirror, receive_timeout)
+        );
+    }
+    m_ranked = m_mirrors;
+}
+
+MirrorSet::~MirrorSet() {
+    join_probes();
+}
+
+std::vector<std::shared_ptr<Mirror>>
+MirrorSet::ranked(const std::string& source) {
+    if (m_mirrors.size() <= 1) {
+        return m_mirrors;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto now = std::chrono::steady_clock::now();
+        const auto expired =
+            m_ranked_time == std::chrono::steady_clock::time_point()
+            || now - m_ranked_time >= config::mirror_ranking_ttl;
+        if (!expired || m_ranking) {
+            return m_ranked;
+        }
+        m_ranking = true;
+    }
+    // probed without the lock, concurrent pulls take the previous ranking
+    // meanwhile
+    std::vector<std::shared_ptr<Mirror>> ranked;
+    try {
+        ranked = rank(source);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ranking = false;
+        throw;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_ranked = std::move(ranked);
+    m_ranked_time = std::chrono::steady_clock::now();
+    m_ranking = false;
+    return m_ranked;
+}
+
+void MirrorSet::join_probes() {
+    for (auto& probe : m_probes) {
+        probe.join();
+    }
+    m_probes.clear();
+}
+
+std::vector<std::shared_ptr<Mirror>>
+MirrorSet::rank(const std::string& source) {
+    // the probes of the last ranking ended with their timeouts long ago
+    join_probes();
+    auto results = std::make_shared<ProbeResults>();
+    results->pending = m_mirrors.size();
+    results->latency.resize(m_mirrors.size());
+
+    for (size_t i = 0; i < m_mirrors.size(); ++i) {
+        m_probes.emplace_back([results, i, mirror = m_mirrors[i], source]() {
+            std::optional<std::chrono::steady_clock::duration> latency;
+            try {
+                const auto start = std::chrono::steady_clock::now();
+                const auto response = mirror->probe(source);
+                const auto status = response->getStatusCode();
+                if (status == Status::CODE_206.code) {
+                    latency = std::chrono::steady_clock::now() - start;
+                    (void)response->readBodyToString();
+                } else {
+                    // a mirror ignoring the range still serves the blob
+                    if (status == Status::CODE_200.code) {
+                        latency = std::chrono::steady_clock::now() - start;
+                    }
+                    discard_response(response);
+                }
+            } catch (const std::exception& e) {
+                OATPP_LOGw(
+                    "MirrorSet",
+                    "probe of {} failed: {}",
+                    mirror->name(),
+                    e.what()
+                );
+            }
+            std::lock_guard<std::mutex> lock(results->mutex);
+            results->latency[i] = latency;
+            --results->pending;
+            results->cv.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(results->mutex);
+    results->cv.wait_for(lock, config::mirror_probe_timeout, [&results]() {
+        return results->pending == 0;
+    });
+
+    std::vector<size_t> order(m_mirrors.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    // latency divided by weight
+    const auto score = [this, &results](size_t i) {
+        return std::chrono::duration<double>(*results->latency[i]).count()
+            / m_mirrors[i]->weight();
+    };
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const auto& latency = results->latency;
+        if (latency[a].has_value() != latency[b].has_value()) {
+            return latency[a].has_value();
+        }
+        if (!latency[a]) {
+            // neither answered
+            return m_mirrors[a]->weight() > m_mirrors[b]->weight();
+        }
+        return score(a) < score(b);
+    });
+
+    std::vector<std::shared_ptr<Mirror>> ranked;
+    for (const auto i : order) {
+        ranked.push_back(m_mirrors[i]);
+    }
+    OATPP_LOGi("MirrorSet", "using mirror {}", ranked.front()->name());
+    return ranked;
+}
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file mirror.hpp
+ * @brief Blob library mirrors
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <oatpp/network/ConnectionPool.hpp>
+#include <oatpp/web/protocol/http/incoming/Response.hpp>
+
+#include "config/runtime_config.hpp"
+#include "download/client.hpp"
+
+/**
+ * A library server with its own pool of keep-alive connections
+ */
+class Mirror {
+  public:
+    using Response = oatpp::web::protocol::http::incoming::Response;
+
+    // a read which gets nothing for receive_timeout fails, zero waits
+    // forever
+    Mirror(const MirrorConfig& config, std::chrono::seconds receive_timeout);
+    ~Mirror();
+
+    // an empty range requests the whole blob
+    std::shared_ptr<Response>
+    request(const std::string& source, const std::string& range);
+    // the first byte over a connection of its own which gives up after the
+    // probe timeout
+    std::shared_ptr<Response> probe(const std::string& source);
+
+    // host:port, for logging
+    const std::string& name() const;
+    uint32_t weight() const;
+
+  private:
+    std::string m_name;
+    uint32_t m_weight;
+    bool m_peer;
+    std::shared_ptr<oatpp::network::ClientConnectionPool> m_connection_pool;
+    std::shared_ptr<DownloadClient> m_client;
+    std::shared_ptr<DownloadClient> m_probe_client;
+};
+
+/**
+ * The configured mirrors, ranked by how fast they answer a one byte range
+ * request. The ranking is kept for a while so consecutive pulls don't probe
+ * again. The probes run on threads of the set which are joined by the next
+ * ranking and the destructor, their connect and read end with the probe
+ * timeout.
+ */
+class MirrorSet {
+  public:
+    MirrorSet(
+        const std::vector<MirrorConfig>& mirrors,
+        std::chrono::seconds receive_timeout
+    );
+    ~MirrorSet();
+
+    MirrorSet(const MirrorSet&) = delete;
+    MirrorSet& operator=(const MirrorSet&) = delete;
+
+    // fastest first; mirrors which didn't answer are kept at the end for
+    // failover
+    std::vector<std::shared_ptr<Mirror>> ranked(const std::string& source);
+
+  private:
+    // by the one thread which ranks
+    std::vector<std::shared_ptr<Mirror>> rank(const std::string& source);
+    void join_probes();
+
+  private:
+    std::vector<std::shared_ptr<Mirror>> m_mirrors;
+
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<Mirror>> m_ranked;
+    std::chrono::steady_clock::time_point m_ranked_time;
+    // a pull is ranking, the others use m_ranked meanwhile
+    bool m_ranking;
+    // only touched by the ranking thread and the destructor
+    std::vector<std::thread> m_probes;
+};
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file progress_channel.cpp
+ * @brief PullProgressChannel implementation
+ **/
+
+#include "download/progress_channel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+PullProgressChannel::PullProgressChannel(
+    std::chrono::milliseconds interval,
+    int64_t bytes
+) :
+    m_interval(interval),
+    m_bytes(bytes),
+    m_sent_completed(0),
+    m_sent_time(),
+    m_done(false) {}
+
+void PullProgressChannel::status(const std::string& status) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PullProgress message;
+    message.status = status;
+    push(std::move(message));
+}
+
+void PullProgressChannel::progress(
+    const std::string& digest,
+    int64_t total,
+    int64_t completed
+) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_done) {
+        return;
+    }
+    PullProgress progress;
+    progress.status = "pulling";
+    progress.digest = digest;
+    progress.total = total;
+    progress.completed = completed;
+    m_pending_progress = std::move(progress);
+    if (progress_due(std::chrono::steady_clock::now())) {
+        m_cv.notify_one();
+    }
+}
+
+void PullProgressChannel::error(const std::string& message) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    PullProgress error;
+    error.error = message;
+    push(std::move(error));
+}
+
+void PullProgressChannel::done() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    flush_progress();
+    m_done = true;
+    m_cv.notify_one();
+}
+
+std::optional<PullProgress>
+PullProgressChannel::wait_next(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        const auto now = std::chrono::steady_clock::now();
+        if (m_pending_progress && progress_due(now)) {
+            flush_progress();
+        }
+        if (!m_messages.empty()) {
+            auto message = std::move(m_messages.front());
+            m_messages.pop_front();
+            m_last_sent = message;
+            return message;
+        }
+        if (m_done) {
+            return std::nullopt;
+        }
+        if (now >= deadline && m_last_sent) {
+            return m_last_sent;
+        }
+
+        // a coalesced byte count becomes due by time, not by a notification
+        auto wake_up = now >= deadline ? now + timeout : deadline;
+        if (m_pending_progress) {
+            wake_up = std::min(wake_up, m_sent_time + m_interval);
+        }
+        m_cv.wait_until(lock, wake_up);
+    }
+}
+
+bool PullProgressChannel::progress_due(
+    std::chrono::steady_clock::time_point now
+) const {
+    return now - m_sent_time >= m_interval
+        || m_pending_progress->completed - m_sent_completed >= m_bytes
+        || m_pending_progress->completed == m_pending_progress->total;
+}
+
+void PullProgressChannel::flush_progress() {
+    if (!m_pending_progress) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsed = std::chrono::duration<double>(now - m_sent_time);
+    const auto bytes = m_pending_progress->completed - m_sent_completed;
+    // nothing to compare the first byte count with
+    if (m_sent_time != std::chrono::steady_clock::time_point()
+        && elapsed.count() > 0 && bytes >= 0) {
+        m_pending_progress->bytes_per_second =
+            static_cast<int64_t>(bytes / elapsed.count());
+    }
+    m_sent_completed = m_pending_progress->completed;
+    m_sent_time = now;
+    m_messages.push_back(std::move(*m_pending_progress));
+    m_pending_progress.reset();
+}
+
+void PullProgressChannel::push(PullProgress message) {
+    if (m_done) {
+        return;
+    }
+    // the byte count must not arrive after the status which follows it
+    flush_progress();
+    m_messages.push_back(std::move(message));
+    m_cv.notify_one();
+}
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file progress_channel.hpp
+ * @brief Progress of a pull, from the download to the HTTP response
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "config/static_config.hpp"
+
+struct PullProgress {
+    std::string status;
+    std::string digest;
+    int64_t total = -1;
+    int64_t completed = -1;
+    std::string error;
+    // since the previous byte count
+    int64_t bytes_per_second = -1;
+};
+
+/**
+ * Status messages and errors are delivered in order. Byte counts are
+ * coalesced: only the latest one is kept, and it is delivered once the
+ * interval passed or enough bytes were added since the last one. Writers
+ * never block on the reader.
+ */
+class PullProgressChannel {
+  public:
+    explicit PullProgressChannel(
+        std::chrono::milliseconds interval = config::pull_progress_interval,
+        int64_t bytes = config::pull_progress_bytes
+    );
+
+    void status(const std::string& status);
+    void progress(const std::string& digest, int64_t total, int64_t completed);
+    void error(const std::string& message);
+    // no messages are added after done()
+    void done();
+
+    // returns std::nullopt once everything was read after done(); on timeout
+    // the last message is returned again to keep the connection alive
+    std::optional<PullProgress> wait_next(std::chrono::milliseconds timeout);
+
+  private:
+    bool progress_due(std::chrono::steady_clock::time_point now) const;
+    void flush_progress();
+    void push(PullProgress message);
+
+  private:
+    const std::chrono::milliseconds m_interval;
+    const int64_t m_bytes;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<PullProgress> m_messages;
+    std::optional<PullProgress> m_pending_progress;
+    std::optional<PullProgress> m_last_sent;
+    int64_t m_sent_completed;
+    std::chrono::steady_clock::time_point m_sent_time;
+    bool m_done;
+};
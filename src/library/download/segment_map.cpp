@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file segment_map.cpp
+ * @brief SegmentMap implementation
+ **/
+
+#include "download/segment_map.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+// blob size and segment size
+constexpr int64_t header_size = 2 * sizeof(int64_t);
+
+[[noreturn]] void throw_errno(const std::string& message) {
+    throw std::system_error(errno, std::generic_category(), message);
+}
+}  // namespace
+
+SegmentMap::SegmentMap(
+    const std::string& target,
+    int64_t total,
+    int64_t segment_size
+) :
+    m_path(path_for(target)),
+    m_target(target),
+    m_total(total),
+    m_segment_size(segment_size),
+    m_done((total + segment_size - 1) / segment_size, 0),
+    m_resumed(false),
+    m_fd(-1) {
+    m_resumed = load();
+    if (!m_resumed) {
+        create();
+    }
+}
+
+SegmentMap::~SegmentMap() {
+    if (m_fd >= 0) {
+        (void)close(m_fd);
+    }
+}
+
+std::string SegmentMap::path_for(const std::string& target) {
+    return fs::path(target).replace_extension(".segments.tmp").string();
+}
+
+bool SegmentMap::exists(const std::string& target) {
+    std::error_code error_code;
+    return fs::is_regular_file(path_for(target), error_code);
+}
+
+void SegmentMap::remove(const std::string& target) {
+    std::error_code error_code;
+    fs::remove(path_for(target), error_code);
+}
+
+bool SegmentMap::resumed() const {
+    return m_resumed;
+}
+
+int64_t SegmentMap::segment_count() const {
+    return static_cast<int64_t>(m_done.size());
+}
+
+bool SegmentMap::done(int64_t segment) const {
+    return m_done[segment] != 0;
+}
+
+int64_t SegmentMap::done_bytes() const {
+    int64_t bytes = 0;
+    for (int64_t segment = 0; segment < segment_count(); ++segment) {
+        if (done(segment)) {
+            const auto begin = segment * m_segment_size;
+            bytes += std::min(m_segment_size, m_total - begin);
+        }
+    }
+    return bytes;
+}
+
+void SegmentMap::mark_done(int64_t segment) {
+    m_done[segment] = 1;
+    const char done = 1;
+    if (pwrite(m_fd, &done, 1, header_size + segment) != 1) {
+        throw_errno("Failed to write " + m_path);
+    }
+}
+
+bool SegmentMap::load() {
+    std::error_code error_code;
+    const auto target_size = fs::file_size(m_target, error_code);
+    if (error_code || static_cast<int64_t>(target_size) != m_total) {
+        return false;
+    }
+    const auto fd = open(m_path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    int64_t header[2] = {0, 0};
+    const auto count = static_cast<ssize_t>(m_done.size());
+    if (pread(fd, header, header_size, 0) != header_size
+        || header[0] != m_total || header[1] != m_segment_size
+        || pread(fd, m_done.data(), count, header_size) != count) {
+        // another layout, or cut short
+        (void)close(fd);
+        std::fill(m_done.begin(), m_done.end(), 0);
+        return false;
+    }
+    m_fd = fd;
+    return true;
+}
+
+void SegmentMap::create() {
+    m_fd = open(
+        m_path.c_str(),
+        O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+        0644
+    );
+    if (m_fd < 0) {
+        throw_errno("Failed to open " + m_path);
+    }
+    const int64_t header[2] = {m_total, m_segment_size};
+    const auto count = static_cast<ssize_t>(m_done.size());
+    if (pwrite(m_fd, header, header_size, 0) != header_size
+        || pwrite(m_fd, m_done.data(), count, header_size) != count) {
+        throw_errno("Failed to write " + m_path);
+    }
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file segment_map.hpp
+ * @brief The completed segments of a segmented download, kept on disk
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A file next to the partial blob holding the blob size, the segment size
+ * and a byte per segment which is set once the segment is in the blob file.
+ * An interrupted segmented download continues with the segments which are
+ * missing. The sha256 of the whole blob is checked at the end, so a segment
+ * lost to a power failure shows up as a bad hash instead of a bad blob.
+ *
+ * The file ends with the same suffix as partial blobs, so the blob store
+ * cleans it up with them.
+ */
+class SegmentMap {
+  public:
+    // continues the map of an earlier download if it has the same layout
+    // and the partial blob still has its full size, otherwise starts one
+    // with no segment done
+    SegmentMap(const std::string& target, int64_t total, int64_t segment_size);
+    ~SegmentMap();
+
+    SegmentMap(const SegmentMap&) = delete;
+    SegmentMap& operator=(const SegmentMap&) = delete;
+
+    static std::string path_for(const std::string& target);
+    static bool exists(const std::string& target);
+    static void remove(const std::string& target);
+
+    // whether segments of an earlier download were found
+    bool resumed() const;
+    int64_t segment_count() const;
+    bool done(int64_t segment) const;
+    // bytes of the blob in done segments
+    int64_t done_bytes() const;
+    // once the segment is written to the blob file, from any thread
+    void mark_done(int64_t segment);
+
+  private:
+    bool load();
+    void create();
+
+  private:
+    std::string m_path;
+    std::string m_target;
+    int64_t m_total;
+    int64_t m_segment_size;
+    std::vector<char> m_done;
+    bool m_resumed;
+    int m_fd;
+};
@@ -0,0 +1,310 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file segmented_download.cpp
+ * @brief SegmentedDownload implementation
+ **/
+
+#include "download/segmented_download.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <oatpp/base/Log.hpp>
+#include <oatpp/data/stream/Stream.hpp>
+
+#include "config/static_config.hpp"
+#include "download/blob_file_writer.hpp"
+#include "download/client.hpp"
+#include "download/in_flight.hpp"
+#include "download/segment_map.hpp"
+#include "download/stall_detector.hpp"
+#include "download/throttle.hpp"
+#include "utils/sha256.hpp"
+
+namespace {
+using Status = oatpp::web::protocol::http::Status;
+
+// Writes a segment of the body at its position in the file
+class SegmentWriter: public oatpp::data::stream::WriteCallback {
+  public:
+    // returns the time the writer was held back
+    using ProgressCallback =
+        std::function<std::chrono::steady_clock::duration(int64_t)>;
+
+    SegmentWriter(
+        const std::string& target,
+        int64_t offset,
+        const DownloadConfig& config,
+        ProgressCallback on_progress
+    ) :
+        m_file(target, offset, false, config.direct_io),
+        m_stall_detector(config),
+        m_on_progress(std::move(on_progress)) {}
+
+    oatpp::v_io_size write(
+        const void* data,
+        v_buff_size count,
+        oatpp::async::Action& action
+    ) override {
+        (void)action;
+        m_file.write(data, count);
+        m_stall_detector.exclude(m_on_progress(count));
+        m_stall_detector.update(count);
+        return count;
+    }
+
+    // returns the position after the data which made it to the file
+    int64_t close() {
+        m_file.close();
+        return m_file.position();
+    }
+
+  private:
+    BlobFileWriter m_file;
+    StallDetector m_stall_detector;
+    ProgressCallback m_on_progress;
+};
+
+// "bytes 0-0/1234" -> 1234
+std::optional<int64_t> total_from_content_range(const std::string& value) {
+    const auto slash = value.rfind('/');
+    if (slash == std::string::npos || value.compare(0, 6, "bytes ") != 0) {
+        return std::nullopt;
+    }
+    try {
+        return std::stoll(value.substr(slash + 1));
+    } catch (const std::exception&) {
+        // "*" means unknown size
+        return std::nullopt;
+    }
+}
+
+std::string make_range(int64_t begin, int64_t end) {
+    return "bytes=" + std::to_string(begin) + "-" + std::to_string(end - 1);
+}
+}  // namespace
+
+SegmentedDownload::SegmentedDownload(
+    RangeRequester requester,
+    std::string resource,
+    std::shared_ptr<InFlightDownload> download,
+    const DownloadConfig& config
+) :
+    m_requester(std::move(requester)),
+    m_resource(std::move(resource)),
+    m_download(std::move(download)),
+    m_config(config),
+    m_connections(std::max<size_t>(config.connections, 1)),
+    m_segment_size(std::max<int64_t>(
+        static_cast<int64_t>(config.segment_size_mb) * 1024 * 1024,
+        1
+    )),
+    m_next_segment(0),
+    m_completed(0),
+    m_failed(false) {}
+
+std::optional<int64_t> SegmentedDownload::probe_size() {
+    const auto response = m_requester(make_range(0, 1), 1);
+    if (response->getStatusCode() != Status::CODE_206.code) {
+        // the body may be the whole blob -> dropped without reading it
+        discard_response(response);
+        return std::nullopt;
+    }
+    (void)response->readBodyToString();
+    return total_from_content_range(
+        response->getHeader("Content-Range").getValue("")
+    );
+}
+
+std::optional<std::string> SegmentedDownload::run(const std::string& target) {
+    const auto total = probe_size();
+    if (!total) {
+        OATPP_LOGi(
+            "SegmentedDownload",
+            "range requests not supported for {}",
+            m_resource
+        );
+        return std::nullopt;
+    }
+    if (*total <= m_segment_size) {
+        // a single segment gains nothing over the hashing single stream
+        return std::nullopt;
+    }
+
+    SegmentMap segments(target, *total, m_segment_size);
+    if (segments.resumed()) {
+        OATPP_LOGi(
+            "SegmentedDownload",
+            "resuming {} with {} bytes done",
+            m_resource,
+            segments.done_bytes()
+        );
+    } else {
+        // the full size up front, segments are written at their position
+        const auto fd =
+            open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::system_error(
+                errno,
+                std::generic_category(),
+                "Failed to open " + target
+            );
+        }
+        const auto allocated =
+            posix_fallocate(fd, 0, *total) == 0 || ftruncate(fd, *total) == 0;
+        const auto error = errno;
+        (void)close(fd);
+        if (!allocated) {
+            throw std::system_error(
+                error,
+                std::generic_category(),
+                "Failed to allocate " + target
+            );
+        }
+    }
+    m_completed = segments.done_bytes();
+    fetch_segments(target, *total, segments);
+
+    // segments arrive out of order -> the digest is calculated at the end
+    m_download->status("verifying sha256 digest");
+    auto digest = SHA256Hasher::hash_file(target);
+    // a bad hash removes the blob file, the map can't be used either way
+    SegmentMap::remove(target);
+    return digest;
+}
+
+void SegmentedDownload::fetch_segments(
+    const std::string& target,
+    int64_t total,
+    SegmentMap& segments
+) {
+    std::vector<int64_t> missing;
+    for (int64_t segment = 0; segment < segments.segment_count(); ++segment) {
+        if (!segments.done(segment)) {
+            missing.push_back(segment);
+        }
+    }
+    const auto missing_count = static_cast<int64_t>(missing.size());
+    const auto thread_count =
+        std::min<int64_t>(static_cast<int64_t>(m_connections), missing_count);
+
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto worker = [&]() {
+        try {
+            for (auto index = m_next_segment++;
+                 index < missing_count && !m_failed;
+                 index = m_next_segment++) {
+                const auto segment = missing[index];
+                const auto begin = segment * m_segment_size;
+                const auto end = std::min(begin + m_segment_size, total);
+                fetch_segment(target, begin, end, total);
+                segments.mark_done(segment);
+            }
+        } catch (...) {
+            m_failed = true;
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (int64_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void SegmentedDownload::fetch_segment(
+    const std::string& target,
+    int64_t begin,
+    int64_t end,
+    int64_t total
+) {
+    for (int attempt = 1;; ++attempt) {
+        auto writer = std::make_shared<SegmentWriter>(
+            target,
+            begin,
+            m_config,
+            [this, total](int64_t count) {
+                report_progress(count, total);
+                return m_download->throttle(count);
+            }
+        );
+        std::shared_ptr<Response> response;
+        std::string failure;
+        try {
+            response = m_requester(make_range(begin, end), attempt);
+            if (response->getStatusCode() != Status::CODE_206.code) {
+                throw std::runtime_error(
+                    "range request failed with status "
+                    + std::to_string(response->getStatusCode())
+                );
+            }
+            response->transferBody(writer);
+        } catch (const DownloadCancelled&) {
+            m_failed = true;
+            throw;
+        } catch (const std::exception& e) {
+            failure = e.what();
+        }
+        try {
+            // continue after whatever made it to the file
+            begin = writer->close();
+        } catch (const std::exception& e) {
+            failure = e.what();
+        }
+        if (failure.empty()) {
+            if (begin >= end) {
+                return;
+            }
+            failure = "connection closed before segment end";
+        }
+
+        if (response) {
+            discard_response(response);
+        }
+        if (attempt >= config::download_max_attempts || m_failed) {
+            throw std::runtime_error(failure);
+        }
+        OATPP_LOGw(
+            "SegmentedDownload",
+            "segment of {} failed (attempt {}): {}",
+            m_resource,
+            attempt,
+            failure
+        );
+        std::this_thread::sleep_for(config::download_retry_delay);
+    }
+}
+
+void SegmentedDownload::report_progress(int64_t count, int64_t total) {
+    m_download->progress(m_resource, total, m_completed += count);
+}
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file segmented_download.hpp
+ * @brief Downloading a blob over several connections in parallel
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <oatpp/web/protocol/http/incoming/Response.hpp>
+
+#include "config/runtime_config.hpp"
+#include "download/in_flight.hpp"
+#include "download/segment_map.hpp"
+
+/**
+ * Splits the blob into segments which are fetched with Range requests over
+ * several connections and written at their position in a preallocated file.
+ * Progress of all segments is published as a single stream. Completed
+ * segments are recorded in a SegmentMap, so an interrupted download only
+ * fetches the missing ones the next time.
+ */
+class SegmentedDownload {
+  public:
+    using Response = oatpp::web::protocol::http::incoming::Response;
+    // attempt starts at 1 for every segment, later attempts may go to
+    // another mirror
+    using RangeRequester = std::function<
+        std::shared_ptr<Response>(const std::string& range, int attempt)>;
+
+    SegmentedDownload(
+        RangeRequester requester,
+        std::string resource,
+        std::shared_ptr<InFlightDownload> download,
+        const DownloadConfig& config
+    );
+
+    // returns std::nullopt if the server doesn't support range requests,
+    // otherwise the sha256 of the downloaded file; on failure the file and
+    // its segment map are kept for the next attempt
+    std::optional<std::string> run(const std::string& target);
+
+  private:
+    std::optional<int64_t> probe_size();
+    void fetch_segments(
+        const std::string& target,
+        int64_t total,
+        SegmentMap& segments
+    );
+    void fetch_segment(
+        const std::string& target,
+        int64_t begin,
+        int64_t end,
+        int64_t total
+    );
+    void report_progress(int64_t count, int64_t total);
+
+  private:
+    RangeRequester m_requester;
+    std::string m_resource;
+    std::shared_ptr<InFlightDownload> m_download;
+    DownloadConfig m_config;
+    size_t m_connections;
+    int64_t m_segment_size;
+
+    std::atomic<int64_t> m_next_segment;
+    std::atomic<int64_t> m_completed;
+    std::atomic<bool> m_failed;
+};
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file stall_detector.cpp
+ * @brief StallDetector implementation
+ **/
+
+#include "download/stall_detector.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "config/runtime_config.hpp"
+
+StallDetector::StallDetector(
+    std::chrono::seconds window,
+    int64_t min_bytes_per_second
+) :
+    m_window(window),
+    m_min_bytes(min_bytes_per_second * window.count()),
+    m_window_start(std::chrono::steady_clock::now()),
+    m_window_bytes(0) {}
+
+StallDetector::StallDetector(const DownloadConfig& config) :
+    StallDetector(
+        std::chrono::seconds(config.stall_timeout_s),
+        static_cast<int64_t>(config.stall_min_rate_kbps) * 1024
+    ) {}
+
+void StallDetector::update(int64_t bytes) {
+    if (m_window.count() == 0) {
+        return;
+    }
+    m_window_bytes += bytes;
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_window_start < m_window) {
+        return;
+    }
+    if (m_window_bytes < m_min_bytes) {
+        throw DownloadStalled(
+            "stalled: " + std::to_string(m_window_bytes) + " bytes in "
+            + std::to_string(m_window.count()) + " s"
+        );
+    }
+    m_window_start = now;
+    m_window_bytes = 0;
+}
+
+void StallDetector::exclude(std::chrono::steady_clock::duration idle) {
+    m_window_start += idle;
+}
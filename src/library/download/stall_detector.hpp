@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file stall_detector.hpp
+ * @brief Detecting downloads which became too slow
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+#include "config/runtime_config.hpp"
+
+class DownloadStalled: public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Throws DownloadStalled when less than the minimum rate arrived over a
+ * whole window. A zero window disables the detection.
+ */
+class StallDetector {
+  public:
+    StallDetector(std::chrono::seconds window, int64_t min_bytes_per_second);
+    explicit StallDetector(const DownloadConfig& config);
+
+    void update(int64_t bytes);
+    // time the download was held back on purpose doesn't count
+    void exclude(std::chrono::steady_clock::duration idle);
+
+  private:
+    std::chrono::seconds m_window;
+    int64_t m_min_bytes;
+    std::chrono::steady_clock::time_point m_window_start;
+    int64_t m_window_bytes;
+};
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file throttle.cpp
+ * @brief DownloadThrottle implementation
+ **/
+
+#include "download/throttle.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "config/static_config.hpp"
+
+DownloadThrottle::DownloadThrottle(
+    uint64_t bytes_per_second,
+    PausePredicate paused
+) :
+    m_bytes_per_second(bytes_per_second),
+    m_paused(std::move(paused)),
+    m_released(false),
+    m_cancelled(false),
+    m_next() {}
+
+std::chrono::steady_clock::duration DownloadThrottle::consume(int64_t bytes) {
+    const auto begin = std::chrono::steady_clock::now();
+    while (!m_released && m_paused && m_paused()) {
+        if (m_cancelled) {
+            throw DownloadCancelled("download cancelled");
+        }
+        std::this_thread::sleep_for(config::download_pause_poll);
+    }
+    if (m_cancelled) {
+        throw DownloadCancelled("download cancelled");
+    }
+    if (m_released || m_bytes_per_second == 0) {
+        return std::chrono::steady_clock::now() - begin;
+    }
+
+    std::chrono::steady_clock::time_point start;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // idle time isn't saved up for a burst
+        m_next = std::max(m_next, std::chrono::steady_clock::now());
+        start = m_next;
+        m_next += std::chrono::nanoseconds(
+            static_cast<uint64_t>(bytes) * 1000000000ULL / m_bytes_per_second
+        );
+    }
+    std::this_thread::sleep_until(start);
+    return std::chrono::steady_clock::now() - begin;
+}
+
+void DownloadThrottle::release() {
+    m_released = true;
+}
+
+void DownloadThrottle::cancel() {
+    m_cancelled = true;
+}
+
+bool DownloadThrottle::limits() const {
+    return !m_released && (m_bytes_per_second > 0 || m_paused);
+}
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file throttle.hpp
+ * @brief Rate limit and pausing of background downloads
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+
+class DownloadCancelled: public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * Paces the writes of a download to a maximum rate and holds them while the
+ * pause predicate is true. Shared by all connections of the download, so the
+ * rate is the total. Once released the download runs at full speed.
+ */
+class DownloadThrottle {
+  public:
+    using PausePredicate = std::function<bool()>;
+
+    // a zero rate is unlimited
+    DownloadThrottle(uint64_t bytes_per_second, PausePredicate paused);
+
+    // returns the time spent waiting, throws DownloadCancelled after cancel()
+    std::chrono::steady_clock::duration consume(int64_t bytes);
+    void release();
+    void cancel();
+    // false once released or without a rate and a pause predicate
+    bool limits() const;
+
+  private:
+    uint64_t m_bytes_per_second;
+    PausePredicate m_paused;
+    std::atomic<bool> m_released;
+    std::atomic<bool> m_cancelled;
+    std::mutex m_mutex;
+    // the earliest time the next write may start
+    std::chrono::steady_clock::time_point m_next;
+};
@@ -172,6 +172,23 @@ class TagsResponse: public oatpp::DTO {
     DTO_FIELD(Vector<Object<ModelInfoShort>>, models);
 };
 
+class BlobInfo: public oatpp::DTO {
+    DTO_INIT(BlobInfo, DTO)
+
+    DTO_FIELD(String, digest);
+    DTO_FIELD(UInt64, size);
+    DTO_FIELD(String, last_used);
+};
+
+class BlobsResponse: public oatpp::DTO {
+    DTO_INIT(BlobsResponse, DTO)
+
+    DTO_FIELD(UInt64, quota);
+    DTO_FIELD(UInt64, used);
+    DTO_FIELD(UInt64, partial);
+    DTO_FIELD(Vector<Object<BlobInfo>>, blobs);
+};
+
 class ShowParams: public oatpp::DTO {
     DTO_INIT(ShowParams, DTO)
 
@@ -196,6 +213,25 @@ class PullParams: public oatpp::DTO {
 
     DTO_FIELD(String, model);
     DTO_FIELD(Boolean, stream) = true;
+    // hash the blob even if it was already verified
+    DTO_FIELD(Boolean, verify) = false;
+};
+
+class ImportParams: public oatpp::DTO {
+    DTO_INIT(ImportParams, DTO)
+
+    // bundle directory or tar archive on the server
+    DTO_FIELD(String, path);
+    // move blobs out of a bundle directory instead of linking them
+    DTO_FIELD(Boolean, move) = false;
+    // progress as ndjson lines like /api/pull instead of a single response
+    DTO_FIELD(Boolean, stream) = false;
+};
+
+class ImportResponse: public oatpp::DTO {
+    DTO_INIT(ImportResponse, DTO)
+
+    DTO_FIELD(Vector<String>, models);
 };
 
 class DeleteParams: public oatpp::DTO {
@@ -218,6 +254,8 @@ class PullResponse: public oatpp::DTO {
     DTO_FIELD(String, digest);
     DTO_FIELD(Int64, total);
     DTO_FIELD(Int64, completed);
+    DTO_FIELD(String, error);
+    DTO_FIELD(Int64, bytes_per_second);
 };
 
 class VersionResponse: public oatpp::DTO {
@@ -16,12 +16,17 @@
 #include <string>
 #include <string_view>
 #include <thread>
+#include <utility>
 
 #include <hailo/genai/llm/llm.hpp>
 #include <hailo/vdevice.hpp>
 #include <oatpp/base/Log.hpp>
 
 #include "config/static_config.hpp"
+#include "logging/log_policy.hpp"
+#include "metrics/server_metrics.hpp"
+#include "model/blob_store.hpp"
+#include "tracing/tracer.hpp"
 
 using namespace std::string_literals;
 
@@ -97,21 +102,39 @@ hailort::genai::LLM* LLMWrapper::operator->() {
     return &m_llm;
 }
 
-GenerationContext::GenerationContext() = default;
+GenerationContext::GenerationContext(
+    std::shared_ptr<HefPrefetcher> prefetcher,
+    std::shared_ptr<ServerMetrics> metrics,
+    std::shared_ptr<BlobStore> blob_store
+) :
+    m_stop_flag(false),
+    m_load_duration(0),
+    m_prefetcher(std::move(prefetcher)),
+    m_metrics(std::move(metrics)),
+    m_blob_store(std::move(blob_store)) {}
 
 void GenerationContext::load_model(
     const std::string& model_name,
     std::filesystem::path model_path,
     std::optional<std::chrono::seconds> keep_alive
 ) {
+    TRACE_SPAN("load_model");
     m_model_name = model_name;
     m_last_generation = std::chrono::steady_clock::now();
     if (keep_alive && (!m_keep_alive || *keep_alive < *m_keep_alive)) {
         m_keep_alive_shortened.notify_one();
     }
     m_keep_alive = keep_alive;
+    m_load_duration = std::chrono::nanoseconds(0);
     if (model_path != m_last_path) {
+        const auto load_begin = std::chrono::steady_clock::now();
         m_last_path = model_path;
+        if (m_prefetcher) {
+            m_prefetcher->loaded(m_last_path);
+        }
+        if (m_blob_store) {
+            m_blob_store->loaded(m_last_path);
+        }
         m_llm.reset();
         // we would like to share the VDevice in the future but it's not supported yet
         m_vdevice.reset();
@@ -133,21 +156,40 @@ void GenerationContext::load_model(
                 .expect("Failed to create LLM")
         );
         m_last_prompt.clear();
+        m_load_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - load_begin
+        );
+        if (m_metrics) {
+            m_metrics->model_loaded(model_name, m_load_duration);
+        }
     }
 }
 
 hailort::genai::LLMGeneratorCompletion
 GenerationContext::generate_one(const Generation& params) {
-    OATPP_LOGi("GenerationThread", "got prompt {}", params.prompt);
+    // the prompt is only copied for the log when it is written
+    if (logging::enabled(oatpp::Logger::PRIORITY_I, "GenerationThread")) {
+        OATPP_LOGi(
+            "GenerationThread",
+            "got prompt {}",
+            logging::excerpt(params.prompt)
+        );
+    }
 
     load_model(params.model_name, params.model_path, params.keep_alive);
     std::string prompt = std::move(params.prompt);
     // check if this is a continuation of previous prompt
-    if (prompt.rfind(m_last_prompt, 0) != std::string::npos
-        && prompt.length() != m_last_prompt.length()) {
+    const auto continuation =
+        prompt.rfind(m_last_prompt, 0) != std::string::npos
+        && prompt.length() != m_last_prompt.length();
+    if (m_metrics) {
+        m_metrics->cache_lookup(ServerMetrics::Cache::CONTEXT, continuation);
+    }
+    if (continuation) {
         prompt = prompt.substr(m_last_prompt.length(), prompt.length());
         m_last_prompt += prompt;
     } else {
+        TRACE_SPAN("clear_context");
         const auto status = (*m_llm)->clear_context();
         if (status != HAILO_SUCCESS) {
             throw hailort::hailort_error(status, "Failed to clear context");
@@ -163,9 +205,19 @@ GenerationContext::generate_one(const Generation& params) {
                          ->create_generator(generator_params)
                          .expect("Failed to create generator");
 
-    auto status = generator.write(prompt);
-    if (HAILO_SUCCESS != status) {
-        throw hailort::hailort_error(status, "Failed to write prompt");
+    if (m_metrics) {
+        // the tokenizer runs on the host, next to the prefill on the device
+        const auto tokens = (*m_llm)->tokenize(prompt);
+        if (tokens) {
+            m_metrics->prompt_written(params.model_name, tokens->size());
+        }
+    }
+    {
+        TRACE_SPAN("prefill");
+        const auto status = generator.write(prompt);
+        if (HAILO_SUCCESS != status) {
+            throw hailort::hailort_error(status, "Failed to write prompt");
+        }
     }
     auto generator_completion =
         generator.generate().expect("Failed to generate");
@@ -173,6 +225,11 @@ GenerationContext::generate_one(const Generation& params) {
     return generator_completion;
 }
 
+std::string read_token(hailort::genai::LLMGeneratorCompletion& completion) {
+    TRACE_SPAN("read");
+    return completion.read().expect("read failed!");
+}
+
 void GenerationContext::append_last_prompt(std::string_view last_prompt) {
     m_last_prompt += last_prompt;
 }
@@ -189,10 +246,20 @@ GenerationContext::get_expiration() const {
     return m_last_generation + *m_keep_alive;
 }
 
+std::chrono::nanoseconds GenerationContext::get_load_duration() const {
+    return m_load_duration;
+}
+
 void GenerationContext::reset() {
     OATPP_LOGi("generation_context", "reset issued");
     m_model_name = "";
     m_last_path = "";
+    if (m_prefetcher) {
+        m_prefetcher->loaded(m_last_path);
+    }
+    if (m_blob_store) {
+        m_blob_store->loaded(m_last_path);
+    }
     m_keep_alive = std::nullopt;
     m_llm.reset();
     m_vdevice.reset();
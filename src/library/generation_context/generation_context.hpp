@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -19,6 +20,10 @@
 #include <hailo/vdevice.hpp>
 #include <libguarded/cs_plain_guarded.h>
 
+#include "generation_context/prefetcher.hpp"
+#include "metrics/server_metrics.hpp"
+#include "model/blob_store.hpp"
+
 struct Generation {
     std::string model_name;
     std::filesystem::path model_path;
@@ -49,7 +54,11 @@ enum class ExpiryWaitStatus { SUCCESS, STOP };
 
 class GenerationContext {
   public:
-    GenerationContext();
+    explicit GenerationContext(
+        std::shared_ptr<HefPrefetcher> prefetcher = nullptr,
+        std::shared_ptr<ServerMetrics> metrics = nullptr,
+        std::shared_ptr<BlobStore> blob_store = nullptr
+    );
     hailort::genai::LLMGeneratorCompletion
 
     generate_one(const Generation& params);
@@ -57,6 +66,8 @@ class GenerationContext {
     std::string get_model_name() const;
 
     std::chrono::steady_clock::time_point get_expiration() const;
+    // time the last load_model() spent loading, 0 if the model was loaded
+    std::chrono::nanoseconds get_load_duration() const;
 
     void append_last_prompt(std::string_view last_prompt);
     void load_model(
@@ -80,6 +91,13 @@ class GenerationContext {
     std::optional<std::chrono::seconds> m_keep_alive;
     std::condition_variable m_keep_alive_shortened;
     bool m_stop_flag;
+    std::chrono::nanoseconds m_load_duration;
+    std::shared_ptr<HefPrefetcher> m_prefetcher;
+    std::shared_ptr<ServerMetrics> m_metrics;
+    std::shared_ptr<BlobStore> m_blob_store;
 };
 
 using SyncGenerationContext = libguarded::plain_guarded<GenerationContext>;
+
+// the next token of a generation, as a traced span
+std::string read_token(hailort::genai::LLMGeneratorCompletion& completion);
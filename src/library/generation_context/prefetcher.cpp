@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file prefetcher.cpp
+ * @brief HefPrefetcher implementation
+ **/
+
+#include "generation_context/prefetcher.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#include <oatpp/base/Log.hpp>
+
+#include "config/static_config.hpp"
+
+HefPrefetcher::HefPrefetcher() :
+    m_stop(false),
+    m_thread(&HefPrefetcher::prefetch_loop, this) {}
+
+HefPrefetcher::~HefPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_queued.notify_one();
+    m_thread.join();
+}
+
+void HefPrefetcher::prefetch(const std::filesystem::path& path) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (path == m_loaded
+            || std::find(m_queue.begin(), m_queue.end(), path)
+                != m_queue.end()) {
+            return;
+        }
+        const auto it = m_prefetched.find(path);
+        if (it != m_prefetched.end()
+            && std::chrono::steady_clock::now() - it->second
+                < config::prefetch_repeat_interval) {
+            return;
+        }
+        m_queue.push_back(path);
+    }
+    m_queued.notify_one();
+}
+
+void HefPrefetcher::loaded(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_loaded = path;
+}
+
+void HefPrefetcher::prefetch_loop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_queued.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_stop) {
+            return;
+        }
+        const auto path = m_queue.front();
+        m_queue.pop_front();
+        lock.unlock();
+        const auto begin = std::chrono::steady_clock::now();
+        read_ahead(path);
+        OATPP_LOGi(
+            "HefPrefetcher",
+            "prefetched {} in {} ms",
+            path.string(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - begin
+            )
+                .count()
+        );
+        lock.lock();
+        m_prefetched[path] = std::chrono::steady_clock::now();
+    }
+}
+
+void HefPrefetcher::read_ahead(const std::filesystem::path& path) {
+    const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    struct stat file_stat {};
+    const auto size = fstat(fd, &file_stat) == 0 ? file_stat.st_size : 0;
+    // chunks keep the I/O queue short and let the destructor interrupt
+    for (off_t offset = 0; offset < size; offset += config::prefetch_chunk) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop) {
+                break;
+            }
+        }
+        const auto length =
+            std::min<off_t>(config::prefetch_chunk, size - offset);
+        if (readahead(fd, offset, static_cast<size_t>(length)) != 0) {
+            // not supported by the filesystem
+            (void)posix_fadvise(fd, offset, length, POSIX_FADV_WILLNEED);
+        }
+    }
+    (void)close(fd);
+}
@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file prefetcher.hpp
+ * @brief Reading HEFs into the page cache ahead of a model load
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/**
+ * Reads HEFs into the page cache on a background thread. A request which has
+ * to wait for the current generation before its model is loaded queues the
+ * HEF here, so the load later finds it in memory instead of reading it cold
+ * from flash.
+ */
+class HefPrefetcher {
+  public:
+    HefPrefetcher();
+    ~HefPrefetcher();
+
+    HefPrefetcher(const HefPrefetcher&) = delete;
+    HefPrefetcher& operator=(const HefPrefetcher&) = delete;
+
+    // ignored for the loaded model and for recently prefetched files
+    void prefetch(const std::filesystem::path& path);
+    // called by the generation context whenever the loaded model changes
+    void loaded(const std::filesystem::path& path);
+
+  private:
+    void prefetch_loop();
+    void read_ahead(const std::filesystem::path& path);
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_queued;
+    std::deque<std::filesystem::path> m_queue;
+    std::filesystem::path m_loaded;
+    std::map<std::filesystem::path, std::chrono::steady_clock::time_point>
+        m_prefetched;
+    bool m_stop;
+    std::thread m_thread;
+};
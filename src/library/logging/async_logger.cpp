@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file async_logger.cpp
+ * @brief AsyncLogger implementation
+ **/
+
+#include "logging/async_logger.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "config/static_config.hpp"
+#include "logging/log_policy.hpp"
+
+namespace {
+char priority_letter(v_uint32 priority) {
+    switch (priority) {
+        case oatpp::Logger::PRIORITY_V:
+            return 'V';
+        case oatpp::Logger::PRIORITY_D:
+            return 'D';
+        case oatpp::Logger::PRIORITY_I:
+            return 'I';
+        case oatpp::Logger::PRIORITY_W:
+            return 'W';
+        case oatpp::Logger::PRIORITY_E:
+            return 'E';
+        default:
+            return '?';
+    }
+}
+
+// " I |2025-01-31 12:00:00.123| tag:message", like oatpp's default logger
+void append_line(
+    std::string& buffer,
+    v_uint32 priority,
+    std::chrono::system_clock::time_point time,
+    const std::string& tag,
+    const std::string& message
+) {
+    const auto seconds = std::chrono::system_clock::to_time_t(time);
+    const auto milliseconds =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            time.time_since_epoch()
+        )
+            .count()
+        % 1000;
+    std::tm local {};
+    localtime_r(&seconds, &local);
+    char stamp[32];
+    const auto length =
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+    char fraction[8];
+    std::snprintf(
+        fraction,
+        sizeof(fraction),
+        ".%03d",
+        static_cast<int>(milliseconds)
+    );
+    buffer += ' ';
+    buffer += priority_letter(priority);
+    buffer += " |";
+    buffer.append(stamp, length);
+    buffer += fraction;
+    buffer += "| ";
+    buffer += tag;
+    buffer += ':';
+    buffer += message;
+    buffer += '\n';
+}
+}  // namespace
+
+AsyncLogger::AsyncLogger() :
+    m_queue(config::log_queue_capacity),
+    m_dropped(0),
+    m_unreported(0),
+    m_sleeping(false),
+    m_stop(false),
+    m_writer(&AsyncLogger::write_loop, this) {}
+
+AsyncLogger::~AsyncLogger() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    m_writer.join();
+}
+
+void AsyncLogger::log(
+    v_uint32 priority,
+    const std::string& tag,
+    const std::string& message
+) {
+    if (!logging::enabled(priority, tag)) {
+        return;
+    }
+    Entry entry {priority, std::chrono::system_clock::now(), tag, message};
+    if (!m_queue.try_push(std::move(entry))) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_unreported.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // a notify racing with the writer going to sleep is lost, the message
+    // then waits for the flush interval
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+        m_wakeup.notify_one();
+    }
+}
+
+bool AsyncLogger::isLogPriorityEnabled(v_uint32 priority) {
+    return priority >= logging::lowest_priority();
+}
+
+uint64_t AsyncLogger::dropped() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::write_loop() {
+    std::string buffer;
+    while (true) {
+        while (write_batch(buffer)) {}
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_stop) {
+            break;
+        }
+        m_sleeping = true;
+        m_wakeup.wait_for(lock, config::log_flush_interval, [this]() {
+            return m_stop || !m_queue.empty();
+        });
+        m_sleeping = false;
+    }
+    // messages logged before the destructor was called
+    while (write_batch(buffer)) {}
+}
+
+bool AsyncLogger::write_batch(std::string& buffer) {
+    buffer.clear();
+    Entry entry;
+    size_t count = 0;
+    while (count < config::log_queue_capacity && m_queue.try_pop(entry)) {
+        append_line(
+            buffer,
+            entry.priority,
+            entry.time,
+            entry.tag,
+            entry.message
+        );
+        ++count;
+    }
+    const auto dropped = m_unreported.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        append_line(
+            buffer,
+            oatpp::Logger::PRIORITY_W,
+            std::chrono::system_clock::now(),
+            "AsyncLogger",
+            std::to_string(dropped) + " messages dropped, the queue was full"
+        );
+    }
+    if (buffer.empty()) {
+        return false;
+    }
+    std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+    std::fflush(stdout);
+    return count > 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file async_logger.hpp
+ * @brief oatpp logger writing from a background thread
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <oatpp/Environment.hpp>
+
+#include "logging/mpsc_queue.hpp"
+
+/**
+ * Installed with oatpp::Environment::setLogger(), so every OATPP_LOG* goes
+ * through it. A message the levels of logging::configure() let through is
+ * moved into a lock-free queue and the calling thread returns; the writer
+ * thread formats and writes the queued messages to stdout in batches. When
+ * the queue is full the message is dropped and counted instead of waiting,
+ * the writer reports the count with its next batch. No lock and no I/O is
+ * ever on the logging thread - the writer is woken with a notify when it
+ * sleeps, which doesn't wait for it.
+ *
+ * Messages still queued are written by the destructor.
+ */
+class AsyncLogger: public oatpp::Logger {
+  public:
+    AsyncLogger();
+    ~AsyncLogger() override;
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    void log(
+        v_uint32 priority,
+        const std::string& tag,
+        const std::string& message
+    ) override;
+    bool isLogPriorityEnabled(v_uint32 priority) override;
+
+    // messages lost to a full queue since the start
+    uint64_t dropped() const;
+
+  private:
+    struct Entry {
+        v_uint32 priority = 0;
+        std::chrono::system_clock::time_point time;
+        std::string tag;
+        std::string message;
+    };
+
+    void write_loop();
+    // false when nothing was queued
+    bool write_batch(std::string& buffer);
+
+  private:
+    MpscQueue<Entry> m_queue;
+    std::atomic<uint64_t> m_dropped;
+    // not reported yet
+    std::atomic<uint64_t> m_unreported;
+    std::atomic<bool> m_sleeping;
+    std::atomic<bool> m_stop;
+    // only for the writer to sleep on
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::thread m_writer;
+};
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file log_policy.cpp
+ * @brief Log policy implementation
+ **/
+
+#include "logging/log_policy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <oatpp/Environment.hpp>
+
+namespace logging {
+
+namespace {
+struct Levels {
+    uint32_t level = oatpp::Logger::PRIORITY_I;
+    std::map<std::string, uint32_t, std::less<>> tags;
+};
+
+struct State {
+    // guards levels together with the version
+    std::mutex mutex;
+    std::shared_ptr<const Levels> levels = std::make_shared<Levels>();
+    std::atomic<uint64_t> version {0};
+    std::atomic<uint32_t> lowest {oatpp::Logger::PRIORITY_I};
+    std::atomic<uint32_t> prompt_bytes {LogConfig().prompt_bytes};
+    std::atomic<uint32_t> sample_every {LogConfig().sample_every};
+};
+
+State& state() {
+    static State state;
+    return state;
+}
+
+uint32_t parse_level(const std::string& name) {
+    static const std::map<std::string, uint32_t, std::less<>> names {
+        {"verbose", oatpp::Logger::PRIORITY_V},
+        {"debug", oatpp::Logger::PRIORITY_D},
+        {"info", oatpp::Logger::PRIORITY_I},
+        {"warning", oatpp::Logger::PRIORITY_W},
+        {"error", oatpp::Logger::PRIORITY_E},
+    };
+    const auto it = names.find(name);
+    if (it == names.end()) {
+        throw std::invalid_argument("unknown log level: " + name);
+    }
+    return it->second;
+}
+
+// every thread keeps the levels it saw last and only takes the mutex after
+// configure() replaced them
+const Levels& thread_levels() {
+    struct Cache {
+        uint64_t version = std::numeric_limits<uint64_t>::max();
+        std::shared_ptr<const Levels> levels;
+    };
+    thread_local Cache cache;
+    auto& current = state();
+    if (cache.version != current.version.load(std::memory_order_acquire)) {
+        const std::lock_guard<std::mutex> lock(current.mutex);
+        cache.levels = current.levels;
+        cache.version = current.version.load(std::memory_order_relaxed);
+    }
+    return *cache.levels;
+}
+}  // namespace
+
+void configure(const LogConfig& config) {
+    auto levels = std::make_shared<Levels>();
+    levels->level = parse_level(config.level);
+    auto lowest = levels->level;
+    for (const auto& [tag, level] : config.tags) {
+        const auto priority = parse_level(level);
+        levels->tags.emplace(tag, priority);
+        lowest = std::min(lowest, priority);
+    }
+
+    auto& current = state();
+    const std::lock_guard<std::mutex> lock(current.mutex);
+    current.levels = std::move(levels);
+    current.version.fetch_add(1, std::memory_order_release);
+    current.lowest.store(lowest, std::memory_order_relaxed);
+    current.prompt_bytes.store(config.prompt_bytes, std::memory_order_relaxed);
+    current.sample_every.store(config.sample_every, std::memory_order_relaxed);
+}
+
+bool enabled(uint32_t priority, std::string_view tag) {
+    if (priority < lowest_priority()) {
+        return false;
+    }
+    const auto& levels = thread_levels();
+    const auto it = levels.tags.find(tag);
+    return priority >= (it == levels.tags.end() ? levels.level : it->second);
+}
+
+uint32_t lowest_priority() {
+    return state().lowest.load(std::memory_order_relaxed);
+}
+
+std::string excerpt(const std::string& text) {
+    const size_t limit = state().prompt_bytes.load(std::memory_order_relaxed);
+    const auto length = "<" + std::to_string(text.size()) + " bytes>";
+    if (limit == 0) {
+        return length;
+    }
+    if (text.size() <= limit) {
+        return text;
+    }
+    auto end = limit;
+    // back to the first byte of a UTF-8 sequence
+    while (end > 0 && (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) {
+        --end;
+    }
+    return text.substr(0, end) + "... " + length;
+}
+
+bool Sampler::sample() {
+    const auto every = state().sample_every.load(std::memory_order_relaxed);
+    const auto count = m_count.fetch_add(1, std::memory_order_relaxed);
+    return every <= 1 || count % every == 0;
+}
+
+}  // namespace logging
@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file log_policy.hpp
+ * @brief Which messages are logged and how much of a prompt they show
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "config/runtime_config.hpp"
+
+namespace logging {
+
+// applies the levels, prompt length and sampling of the configuration at
+// once, throws std::invalid_argument on an unknown level and keeps the
+// previous policy
+void configure(const LogConfig& config);
+
+// whether a message of tag at an oatpp::Logger priority passes the levels,
+// two atomic loads and a map lookup unless the levels changed meanwhile
+bool enabled(uint32_t priority, std::string_view tag);
+// the lowest priority of any tag
+uint32_t lowest_priority();
+
+// the first prompt_bytes of a prompt, not cutting a UTF-8 character, and its
+// length, or only its length when prompt_bytes is 0
+std::string excerpt(const std::string& text);
+
+/**
+ * Passes one in every sample_every calls, for messages which would otherwise
+ * be repeated for every model or token. The count is kept per sampler.
+ */
+class Sampler {
+  public:
+    bool sample();
+
+  private:
+    std::atomic<uint64_t> m_count {0};
+};
+
+}  // namespace logging
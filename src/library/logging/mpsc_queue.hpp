@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file mpsc_queue.hpp
+ * @brief Bounded lock-free queue with many producers and one consumer
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * A ring of cells, each with a sequence number telling whether it is free for
+ * the producer at that position or filled for the consumer. A producer claims
+ * a position with one compare-and-swap and never waits: try_push() fails when
+ * the ring is full. Only one thread may call try_pop() and empty().
+ */
+template <typename T>
+class MpscQueue {
+  public:
+    // capacity must be a power of two
+    explicit MpscQueue(size_t capacity) :
+        m_mask(capacity - 1),
+        m_cells(std::make_unique<Cell[]>(capacity)),
+        m_enqueue(0),
+        m_dequeue(0) {
+        if (capacity == 0 || (capacity & m_mask) != 0) {
+            throw std::invalid_argument(
+                "queue capacity must be a power of two"
+            );
+        }
+        for (size_t i = 0; i < capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // false without moving from value when the queue is full
+    bool try_push(T&& value) {
+        auto position = m_enqueue.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true) {
+            cell = &m_cells[position & m_mask];
+            const auto sequence =
+                cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<intptr_t>(sequence)
+                - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (m_enqueue.compare_exchange_weak(
+                        position,
+                        position + 1,
+                        std::memory_order_relaxed
+                    )) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // the consumer hasn't freed this cell yet
+                return false;
+            } else {
+                position = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        auto& cell = m_cells[m_dequeue & m_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != m_dequeue + 1) {
+            return false;
+        }
+        value = std::move(cell.value);
+        cell.sequence.store(m_dequeue + m_mask + 1, std::memory_order_release);
+        ++m_dequeue;
+        return true;
+    }
+
+    bool empty() const {
+        const auto& cell = m_cells[m_dequeue & m_mask];
+        return cell.sequence.load(std::memory_order_acquire) != m_dequeue + 1;
+    }
+
+  private:
+    struct Cell {
+        std::atomic<size_t> sequence {0};
+        T value;
+    };
+
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    // producers and the consumer on separate cache lines
+    alignas(64) std::atomic<size_t> m_enqueue;
+    alignas(64) size_t m_dequeue;
+};
@@ -0,0 +1,304 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics.cpp
+ * @brief Counter, Histogram and Registry implementation
+ **/
+
+#include "metrics/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metrics {
+
+namespace {
+std::string format_value(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    char buffer[32];
+    (void)std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    return buffer;
+}
+
+void write_sample(
+    std::string& out,
+    const std::string& name,
+    const std::string& labels,
+    const std::string& value
+) {
+    out += name;
+    if (!labels.empty()) {
+        out += '{';
+        out += labels;
+        out += '}';
+    }
+    out += ' ';
+    out += value;
+    out += '\n';
+}
+
+void escape(std::string& out, const std::string& value, bool quotes) {
+    for (const auto character : value) {
+        switch (character) {
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '"':
+                out += quotes ? "\\\"" : "\"";
+                break;
+            default:
+                out += character;
+        }
+    }
+}
+}  // namespace
+
+size_t this_thread_shard() {
+    static std::atomic<size_t> next_shard {0};
+    thread_local const size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % shard_count;
+    return shard;
+}
+
+Counter::Counter() : m_shards() {}
+
+void Counter::add(uint64_t value) {
+    m_shards[this_thread_shard()].value.fetch_add(
+        value,
+        std::memory_order_relaxed
+    );
+}
+
+uint64_t Counter::value() const {
+    uint64_t total = 0;
+    for (const auto& shard : m_shards) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Histogram::Shard::Shard(size_t bucket_count) :
+    buckets(bucket_count),
+    sum(0.0) {}
+
+Histogram::Histogram(std::vector<double> bounds) : m_bounds(std::move(bounds)) {
+    if (!std::is_sorted(m_bounds.begin(), m_bounds.end())) {
+        throw std::invalid_argument("histogram bounds must be increasing");
+    }
+    m_shards.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+        // the last bucket is +Inf
+        m_shards.push_back(std::make_unique<Shard>(m_bounds.size() + 1));
+    }
+}
+
+void Histogram::observe(double value) {
+    const auto bucket = static_cast<size_t>(
+        std::lower_bound(m_bounds.begin(), m_bounds.end(), value)
+        - m_bounds.begin()
+    );
+    auto& shard = *m_shards[this_thread_shard()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    // other threads rarely share the shard -> the loop almost never repeats
+    auto sum = shard.sum.load(std::memory_order_relaxed);
+    while (!shard.sum.compare_exchange_weak(
+        sum,
+        sum + value,
+        std::memory_order_relaxed
+    )) {
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.bounds = m_bounds;
+    snapshot.buckets.assign(m_bounds.size() + 1, 0);
+    for (const auto& shard : m_shards) {
+        for (size_t i = 0; i < shard->buckets.size(); ++i) {
+            snapshot.buckets[i] +=
+                shard->buckets[i].load(std::memory_order_relaxed);
+        }
+        snapshot.sum += shard->sum.load(std::memory_order_relaxed);
+    }
+    for (size_t i = 1; i < snapshot.buckets.size(); ++i) {
+        snapshot.buckets[i] += snapshot.buckets[i - 1];
+    }
+    return snapshot;
+}
+
+void write_samples(
+    std::string& out,
+    const std::string& name,
+    const std::string& labels,
+    const Counter& counter
+) {
+    write_sample(out, name, labels, std::to_string(counter.value()));
+}
+
+void write_samples(
+    std::string& out,
+    const std::string& name,
+    const std::string& labels,
+    const Histogram& histogram
+) {
+    const auto snapshot = histogram.snapshot();
+    const auto prefix = labels.empty() ? labels : labels + ",";
+    for (size_t i = 0; i < snapshot.buckets.size(); ++i) {
+        const auto bound = (i < snapshot.bounds.size())
+            ? format_value(snapshot.bounds[i])
+            : "+Inf";
+        write_sample(
+            out,
+            name + "_bucket",
+            prefix + "le=\"" + bound + "\"",
+            std::to_string(snapshot.buckets[i])
+        );
+    }
+    write_sample(out, name + "_sum", labels, format_value(snapshot.sum));
+    write_sample(
+        out,
+        name + "_count",
+        labels,
+        std::to_string(snapshot.buckets.back())
+    );
+}
+
+std::string format_labels(const Labels& names, const Labels& values) {
+    if (names.size() != values.size()) {
+        throw std::invalid_argument("label values don't match the names");
+    }
+    std::string labels;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (i > 0) {
+            labels += ',';
+        }
+        labels += names[i];
+        labels += "=\"";
+        escape(labels, values[i], true);
+        labels += '"';
+    }
+    return labels;
+}
+
+Collector::Collector(std::string name, std::string help, std::string type) :
+    m_name(std::move(name)),
+    m_help(std::move(help)),
+    m_type(std::move(type)) {}
+
+void Collector::render(std::string& out) const {
+    out += "# HELP " + m_name + " ";
+    escape(out, m_help, false);
+    out += "\n# TYPE " + m_name + " " + m_type + "\n";
+    render_samples(out);
+}
+
+CallbackMetric::CallbackMetric(
+    std::string name,
+    std::string help,
+    std::string type,
+    Reader reader
+) :
+    Collector(std::move(name), std::move(help), std::move(type)),
+    m_reader(std::move(reader)) {}
+
+void CallbackMetric::render_samples(std::string& out) const {
+    write_sample(out, m_name, "", format_value(m_reader()));
+}
+
+Counter& Registry::counter(const std::string& name, const std::string& help) {
+    return counter_family(name, help, {}).with({});
+}
+
+Family<Counter>& Registry::counter_family(
+    const std::string& name,
+    const std::string& help,
+    Labels label_names
+) {
+    auto family = std::make_unique<Family<Counter>>(
+        name,
+        help,
+        "counter",
+        std::move(label_names),
+        []() { return std::make_unique<Counter>(); }
+    );
+    auto& result = *family;
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_collectors.push_back(std::move(family));
+    return result;
+}
+
+Histogram& Registry::histogram(
+    const std::string& name,
+    const std::string& help,
+    std::vector<double> bounds
+) {
+    return histogram_family(name, help, {}, std::move(bounds)).with({});
+}
+
+Family<Histogram>& Registry::histogram_family(
+    const std::string& name,
+    const std::string& help,
+    Labels label_names,
+    std::vector<double> bounds
+) {
+    auto family = std::make_unique<Family<Histogram>>(
+        name,
+        help,
+        "histogram",
+        std::move(label_names),
+        [bounds = std::move(bounds)]() {
+            return std::make_unique<Histogram>(bounds);
+        }
+    );
+    auto& result = *family;
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_collectors.push_back(std::move(family));
+    return result;
+}
+
+void Registry::gauge(
+    const std::string& name,
+    const std::string& help,
+    CallbackMetric::Reader reader
+) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_collectors.push_back(
+        std::make_unique<CallbackMetric>(
+            name,
+            help,
+            "gauge",
+            std::move(reader)
+        )
+    );
+}
+
+std::string Registry::render() const {
+    std::string out;
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (const auto& collector : m_collectors) {
+        collector->render(out);
+    }
+    return out;
+}
+
+}  // namespace metrics
@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file metrics.hpp
+ * @brief Counters and histograms exported in the Prometheus text format
+ **/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace metrics {
+
+constexpr size_t shard_count = 16;
+
+// every thread updates its own shard, so hot counters don't share a cache line
+size_t this_thread_shard();
+
+/**
+ * Monotonic counter. Updates are relaxed atomic adds on the shard of the
+ * calling thread; value() sums the shards.
+ */
+class Counter {
+  public:
+    Counter();
+
+    void add(uint64_t value = 1);
+    uint64_t value() const;
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value {0};
+    };
+
+    std::array<Shard, shard_count> m_shards;
+};
+
+struct HistogramSnapshot {
+    std::vector<double> bounds;
+    // cumulative, the last one is +Inf and equals the count
+    std::vector<uint64_t> buckets;
+    double sum = 0.0;
+};
+
+/**
+ * Histogram with fixed upper bounds. Like Counter, observations go to the
+ * shard of the calling thread.
+ */
+class Histogram {
+  public:
+    // bounds must be increasing, +Inf is implicit
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+    template <typename Rep, typename Period>
+    void observe(std::chrono::duration<Rep, Period> duration) {
+        observe(std::chrono::duration<double>(duration).count());
+    }
+    HistogramSnapshot snapshot() const;
+
+  private:
+    struct alignas(64) Shard {
+        explicit Shard(size_t bucket_count);
+
+        std::vector<std::atomic<uint64_t>> buckets;
+        std::atomic<double> sum;
+    };
+
+    std::vector<double> m_bounds;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+};
+
+using Labels = std::vector<std::string>;
+
+// one sample line per value, in the Prometheus text format
+void write_samples(
+    std::string& out,
+    const std::string& name,
+    const std::string& labels,
+    const Counter& counter
+);
+void write_samples(
+    std::string& out,
+    const std::string& name,
+    const std::string& labels,
+    const Histogram& histogram
+);
+// name="value",... with the values escaped
+std::string format_labels(const Labels& names, const Labels& values);
+
+class Collector {
+  public:
+    Collector(std::string name, std::string help, std::string type);
+    virtual ~Collector() = default;
+
+    // HELP and TYPE lines followed by the samples
+    void render(std::string& out) const;
+
+  protected:
+    virtual void render_samples(std::string& out) const = 0;
+
+  protected:
+    const std::string m_name;
+
+  private:
+    const std::string m_help;
+    const std::string m_type;
+};
+
+/**
+ * Metrics of one name, one per combination of label values. A new
+ * combination takes the write lock once, later lookups only the read lock;
+ * callers on hot paths keep the returned reference, which stays valid.
+ */
+template <typename Metric>
+class Family: public Collector {
+  public:
+    using Factory = std::function<std::unique_ptr<Metric>()>;
+
+    Family(
+        std::string name,
+        std::string help,
+        std::string type,
+        Labels label_names,
+        Factory factory
+    ) :
+        Collector(std::move(name), std::move(help), std::move(type)),
+        m_label_names(std::move(label_names)),
+        m_factory(std::move(factory)) {}
+
+    Metric& with(const Labels& label_values) {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            const auto it = m_metrics.find(label_values);
+            if (it != m_metrics.end()) {
+                return *it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        auto& metric = m_metrics[label_values];
+        if (!metric) {
+            metric = m_factory();
+        }
+        return *metric;
+    }
+
+  protected:
+    void render_samples(std::string& out) const override {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        for (const auto& [label_values, metric] : m_metrics) {
+            write_samples(
+                out,
+                m_name,
+                format_labels(m_label_names, label_values),
+                *metric
+            );
+        }
+    }
+
+  private:
+    const Labels m_label_names;
+    const Factory m_factory;
+    mutable std::shared_mutex m_mutex;
+    std::map<Labels, std::unique_ptr<Metric>> m_metrics;
+};
+
+/**
+ * Value read from elsewhere at scrape time, e.g. the open connections.
+ */
+class CallbackMetric: public Collector {
+  public:
+    using Reader = std::function<double()>;
+
+    CallbackMetric(
+        std::string name,
+        std::string help,
+        std::string type,
+        Reader reader
+    );
+
+  protected:
+    void render_samples(std::string& out) const override;
+
+  private:
+    const Reader m_reader;
+};
+
+/**
+ * Owns the metrics and renders them. Metrics are registered at startup, the
+ * returned references live as long as the registry.
+ */
+class Registry {
+  public:
+    Counter& counter(const std::string& name, const std::string& help);
+    Family<Counter>& counter_family(
+        const std::string& name,
+        const std::string& help,
+        Labels label_names
+    );
+    Histogram& histogram(
+        const std::string& name,
+        const std::string& help,
+        std::vector<double> bounds
+    );
+    Family<Histogram>& histogram_family(
+        const std::string& name,
+        const std::string& help,
+        Labels label_names,
+        std::vector<double> bounds
+    );
+    void gauge(
+        const std::string& name,
+        const std::string& help,
+        CallbackMetric::Reader reader
+    );
+
+    // the text exposition format, version 0.0.4
+    std::string render() const;
+
+  private:
+    mutable std::shared_mutex m_mutex;
+    std::vector<std::unique_ptr<Collector>> m_collectors;
+};
+
+}  // namespace metrics
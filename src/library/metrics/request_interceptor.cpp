@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file request_interceptor.cpp
+ * @brief RequestMetricsInterceptor implementation
+ **/
+
+#include "metrics/request_interceptor.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <oatpp/web/server/HttpRouter.hpp>
+
+#include "metrics/server_metrics.hpp"
+
+namespace {
+constexpr auto begin_key = "metrics.begin";
+constexpr auto blob_prefix = "/hailo/v1/blob/";
+
+// the client picks the method -> only known ones get a series of their own
+std::string method_label(const std::string& method) {
+    for (const auto* known : {"GET", "POST", "DELETE", "HEAD"}) {
+        if (method == known) {
+            return method;
+        }
+    }
+    return "other";
+}
+
+int64_t now_ticks() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+}  // namespace
+
+RequestMetricsInterceptor::RequestMetricsInterceptor(
+    std::shared_ptr<ServerMetrics> metrics,
+    std::shared_ptr<oatpp::web::server::HttpRouter> router
+) :
+    m_metrics(std::move(metrics)),
+    m_router(std::move(router)) {}
+
+std::shared_ptr<RequestMetricsInterceptor::OutgoingResponse>
+RequestMetricsInterceptor::intercept(
+    const std::shared_ptr<IncomingRequest>& request
+) {
+    request->putBundleData(begin_key, oatpp::Int64(now_ticks()));
+    // continue to the endpoint
+    return nullptr;
+}
+
+std::shared_ptr<RequestMetricsInterceptor::OutgoingResponse>
+RequestMetricsInterceptor::intercept(
+    const std::shared_ptr<IncomingRequest>& request,
+    const std::shared_ptr<OutgoingResponse>& response
+) {
+    if (!request || !response) {
+        return response;
+    }
+    const auto begin = request->getBundleData<oatpp::Int64>(begin_key);
+    if (!begin) {
+        return response;
+    }
+    const auto duration =
+        std::chrono::steady_clock::duration(now_ticks() - *begin);
+    const auto& starting_line = request->getStartingLine();
+    const auto method = starting_line.method.toString();
+    const auto path = starting_line.path.toString();
+    m_metrics->request_finished(
+        method_label(method),
+        route_label(method, path),
+        response->getStatus().code,
+        duration
+    );
+    return response;
+}
+
+std::string RequestMetricsInterceptor::route_label(
+    const std::string& method,
+    const std::string& path
+) {
+    if (!m_router->getRoute(method, path)) {
+        return "unmatched";
+    }
+    const auto route = path.substr(0, path.find('?'));
+    if (route.rfind(blob_prefix, 0) == 0) {
+        return std::string(blob_prefix) + "{digest}";
+    }
+    return route;
+}
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file request_interceptor.hpp
+ * @brief Counting the HTTP requests by endpoint and status
+ **/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <oatpp/web/server/HttpRouter.hpp>
+#include <oatpp/web/server/interceptor/RequestInterceptor.hpp>
+#include <oatpp/web/server/interceptor/ResponseInterceptor.hpp>
+
+#include "metrics/server_metrics.hpp"
+
+/**
+ * Notes the arrival time of every request and records it with the response
+ * status once the endpoint returned. Paths are reduced to their route - the
+ * digest of a blob request is dropped and paths without a route are counted
+ * together - so clients can't grow the number of series.
+ */
+class RequestMetricsInterceptor:
+    public oatpp::web::server::interceptor::RequestInterceptor,
+    public oatpp::web::server::interceptor::ResponseInterceptor {
+  public:
+    // both bases declare them
+    using IncomingRequest = oatpp::web::protocol::http::incoming::Request;
+    using OutgoingResponse = oatpp::web::protocol::http::outgoing::Response;
+
+    RequestMetricsInterceptor(
+        std::shared_ptr<ServerMetrics> metrics,
+        std::shared_ptr<oatpp::web::server::HttpRouter> router
+    );
+
+    std::shared_ptr<OutgoingResponse>
+    intercept(const std::shared_ptr<IncomingRequest>& request) override;
+    std::shared_ptr<OutgoingResponse> intercept(
+        const std::shared_ptr<IncomingRequest>& request,
+        const std::shared_ptr<OutgoingResponse>& response
+    ) override;
+
+  private:
+    std::string route_label(const std::string& method, const std::string& path);
+
+  private:
+    std::shared_ptr<ServerMetrics> m_metrics;
+    std::shared_ptr<oatpp::web::server::HttpRouter> m_router;
+};
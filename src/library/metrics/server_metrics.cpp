@@ -0,0 +1,242 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file server_metrics.cpp
+ * @brief ServerMetrics implementation
+ **/
+
+#include "metrics/server_metrics.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config/static_config.hpp"
+#include "metrics/metrics.hpp"
+
+namespace {
+// seconds, from a millisecond to a few minutes
+std::vector<double> duration_bounds() {
+    return {
+        0.001,
+        0.0025,
+        0.005,
+        0.01,
+        0.025,
+        0.05,
+        0.1,
+        0.25,
+        0.5,
+        1,
+        2.5,
+        5,
+        10,
+        30,
+        60,
+        120,
+        300,
+    };
+}
+
+std::vector<double> tokens_per_second_bounds() {
+    return {1, 2, 4, 6, 8, 10, 15, 20, 30, 50, 75, 100, 200};
+}
+
+// bytes per second, from 100 KB/s to 1 GB/s
+std::vector<double> throughput_bounds() {
+    return {1e5, 5e5, 1e6, 5e6, 1e7, 2.5e7, 5e7, 1e8, 2.5e8, 5e8, 1e9};
+}
+
+double seconds(ServerMetrics::Duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+const char* cache_name(ServerMetrics::Cache cache) {
+    switch (cache) {
+        case ServerMetrics::Cache::MODEL_INFO:
+            return "model_info";
+        case ServerMetrics::Cache::TAGS:
+            return "tags";
+        case ServerMetrics::Cache::CONTEXT:
+            return "context";
+    }
+    return "unknown";
+}
+}  // namespace
+
+ServerMetrics::LockHold::LockHold(std::shared_ptr<ServerMetrics> metrics) :
+    m_metrics(std::move(metrics)),
+    m_begin(std::chrono::steady_clock::now()) {}
+
+ServerMetrics::LockHold::~LockHold() {
+    // a moved-from instance has no metrics
+    if (m_metrics) {
+        m_metrics->lock_held(std::chrono::steady_clock::now() - m_begin);
+    }
+}
+
+ServerMetrics::ServerMetrics() :
+    m_registry(),
+    m_requests(m_registry.counter_family(
+        "hailo_http_requests_total",
+        "HTTP requests by endpoint and status",
+        {"method", "path", "status"}
+    )),
+    m_request_duration(m_registry.histogram_family(
+        "hailo_http_request_duration_seconds",
+        "Time until the response headers, streamed bodies are not included",
+        {"path"},
+        duration_bounds()
+    )),
+    m_queue_wait(m_registry.histogram(
+        "hailo_generation_queue_wait_seconds",
+        "Time requests waited for the generation context",
+        duration_bounds()
+    )),
+    m_lock_hold(m_registry.histogram(
+        "hailo_generation_lock_hold_seconds",
+        "Time a request held the generation context",
+        duration_bounds()
+    )),
+    m_model_loads(m_registry.counter_family(
+        "hailo_model_loads_total",
+        "Models loaded to the device, each one replaces the previous",
+        {"model"}
+    )),
+    m_model_load_duration(m_registry.histogram(
+        "hailo_model_load_duration_seconds",
+        "Time to replace the model on the device",
+        duration_bounds()
+    )),
+    m_cache_lookups(m_registry.counter_family(
+        "hailo_cache_lookups_total",
+        "Cache lookups by cache and result",
+        {"cache", "result"}
+    )),
+    m_prompt_tokens(m_registry.counter_family(
+        "hailo_prompt_tokens_total",
+        "Prompt tokens written to the device, without the reused context",
+        {"model"}
+    )),
+    m_completion_tokens(m_registry.counter_family(
+        "hailo_completion_tokens_total",
+        "Tokens generated",
+        {"model"}
+    )),
+    m_time_to_first_token(m_registry.histogram_family(
+        "hailo_time_to_first_token_seconds",
+        "Time from the start of a generation request to its first token",
+        {"model"},
+        duration_bounds()
+    )),
+    m_tokens_per_second(m_registry.histogram_family(
+        "hailo_generation_tokens_per_second",
+        "Generation speed after the first token",
+        {"model"},
+        tokens_per_second_bounds()
+    )),
+    m_stream_write(m_registry.histogram(
+        "hailo_stream_write_seconds",
+        "Time to write a streamed chunk to the client",
+        duration_bounds()
+    )),
+    m_stream_stalls(m_registry.counter(
+        "hailo_stream_write_stalls_total",
+        "Streamed chunks which were slow to write, the device waited for them"
+    )),
+    m_pull_bytes(m_registry.counter(
+        "hailo_pull_bytes_total",
+        "Bytes received by model pulls, counted when a download ends"
+    )),
+    m_pulls(m_registry.counter_family(
+        "hailo_pulls_total",
+        "Downloads of model blobs by result",
+        {"result"}
+    )),
+    m_pull_throughput(m_registry.histogram(
+        "hailo_pull_throughput_bytes_per_second",
+        "Average rate of each finished download",
+        throughput_bounds()
+    )) {}
+
+metrics::Registry& ServerMetrics::registry() {
+    return m_registry;
+}
+
+std::string ServerMetrics::render() const {
+    return m_registry.render();
+}
+
+void ServerMetrics::request_finished(
+    const std::string& method,
+    const std::string& path,
+    int status,
+    Duration duration
+) {
+    m_requests.with({method, path, std::to_string(status)}).add();
+    m_request_duration.with({path}).observe(duration);
+}
+
+void ServerMetrics::queue_waited(Duration duration) {
+    m_queue_wait.observe(duration);
+}
+
+void ServerMetrics::lock_held(Duration duration) {
+    m_lock_hold.observe(duration);
+}
+
+void ServerMetrics::model_loaded(const std::string& model, Duration duration) {
+    m_model_loads.with({model}).add();
+    m_model_load_duration.observe(duration);
+}
+
+void ServerMetrics::cache_lookup(Cache cache, bool hit) {
+    m_cache_lookups.with({cache_name(cache), hit ? "hit" : "miss"}).add();
+}
+
+void ServerMetrics::prompt_written(const std::string& model, uint64_t tokens) {
+    m_prompt_tokens.with({model}).add(tokens);
+}
+
+void ServerMetrics::first_token(const std::string& model, Duration duration) {
+    m_time_to_first_token.with({model}).observe(duration);
+}
+
+void ServerMetrics::generation_finished(
+    const std::string& model,
+    uint64_t tokens,
+    Duration duration
+) {
+    m_completion_tokens.with({model}).add(tokens);
+    if (tokens > 0 && duration.count() > 0) {
+        m_tokens_per_second.with({model}).observe(
+            static_cast<double>(tokens) / seconds(duration)
+        );
+    }
+}
+
+void ServerMetrics::stream_written(Duration duration) {
+    m_stream_write.observe(duration);
+    if (duration > config::metrics_stream_stall_threshold) {
+        m_stream_stalls.add();
+    }
+}
+
+void ServerMetrics::pull_finished(
+    uint64_t bytes,
+    Duration duration,
+    bool success
+) {
+    m_pull_bytes.add(bytes);
+    m_pulls.with({success ? "success" : "error"}).add();
+    if (success && bytes > 0 && duration.count() > 0) {
+        m_pull_throughput.observe(
+            static_cast<double>(bytes) / seconds(duration)
+        );
+    }
+}
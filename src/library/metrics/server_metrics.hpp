@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file server_metrics.hpp
+ * @brief The metrics the server exports on /metrics
+ **/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "metrics/metrics.hpp"
+
+/**
+ * Everything measured by the server, named after the event which updates it.
+ * The components which update them take a nullable pointer, like the
+ * prefetcher - null when metrics are disabled.
+ */
+class ServerMetrics {
+  public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    enum class Cache {
+        // filesystem stats and details per model
+        MODEL_INFO,
+        // the serialized /api/tags body
+        TAGS,
+        // the device context continues the previous conversation
+        CONTEXT,
+    };
+
+    // records the time until destruction as lock_held(), does nothing without
+    // metrics
+    class LockHold {
+      public:
+        explicit LockHold(std::shared_ptr<ServerMetrics> metrics);
+        ~LockHold();
+        LockHold(LockHold&& other) noexcept = default;
+        LockHold& operator=(LockHold&& other) = delete;
+        LockHold(const LockHold&) = delete;
+        LockHold& operator=(const LockHold&) = delete;
+
+      private:
+        std::shared_ptr<ServerMetrics> m_metrics;
+        std::chrono::steady_clock::time_point m_begin;
+    };
+
+    ServerMetrics();
+
+    // for values read at scrape time
+    metrics::Registry& registry();
+    std::string render() const;
+
+    // until the response headers, the body of a stream isn't included
+    void request_finished(
+        const std::string& method,
+        const std::string& path,
+        int status,
+        Duration duration
+    );
+    // waiting for the generation context
+    void queue_waited(Duration duration);
+    // holding the generation context, for a load or a whole generation
+    void lock_held(Duration duration);
+    void model_loaded(const std::string& model, Duration duration);
+    void cache_lookup(Cache cache, bool hit);
+    // tokens written to the device, without the reused context
+    void prompt_written(const std::string& model, uint64_t tokens);
+    // from the start of the request to the first token
+    void first_token(const std::string& model, Duration duration);
+    // tokens / duration, from the first token to the last
+    void generation_finished(
+        const std::string& model,
+        uint64_t tokens,
+        Duration duration
+    );
+    // time oatpp spent writing the previous chunk of a stream
+    void stream_written(Duration duration);
+    void pull_finished(uint64_t bytes, Duration duration, bool success);
+
+  private:
+    metrics::Registry m_registry;
+    metrics::Family<metrics::Counter>& m_requests;
+    metrics::Family<metrics::Histogram>& m_request_duration;
+    metrics::Histogram& m_queue_wait;
+    metrics::Histogram& m_lock_hold;
+    metrics::Family<metrics::Counter>& m_model_loads;
+    metrics::Histogram& m_model_load_duration;
+    metrics::Family<metrics::Counter>& m_cache_lookups;
+    metrics::Family<metrics::Counter>& m_prompt_tokens;
+    metrics::Family<metrics::Counter>& m_completion_tokens;
+    metrics::Family<metrics::Histogram>& m_time_to_first_token;
+    metrics::Family<metrics::Histogram>& m_tokens_per_second;
+    metrics::Histogram& m_stream_write;
+    metrics::Counter& m_stream_stalls;
+    metrics::Counter& m_pull_bytes;
+    metrics::Family<metrics::Counter>& m_pulls;
+    metrics::Histogram& m_pull_throughput;
+};
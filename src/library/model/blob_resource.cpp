@@ -9,24 +9,36 @@
 
 #include "model/blob_resource.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
-#include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
 
-#include <oatpp-openssl/Config.hpp>
-#include <oatpp-openssl/client/ConnectionProvider.hpp>
+#include <oatpp/base/Log.hpp>
 #include <oatpp/data/stream/FileStream.hpp>
-#include <oatpp/json/ObjectMapper.hpp>
-#include <oatpp/network/tcp/client/ConnectionProvider.hpp>
-#include <oatpp/web/client/HttpRequestExecutor.hpp>
 #include <oatpp/web/protocol/http/incoming/Response.hpp>
 
-#include "controller/pull_callback.hpp"
+#include "config/static_config.hpp"
 #include "controller/writefile_callback.hpp"
 #include "download/client.hpp"
+#include "download/in_flight.hpp"
+#include "download/mirror.hpp"
+#include "download/progress_channel.hpp"
+#include "download/segment_map.hpp"
+#include "download/segmented_download.hpp"
+#include "download/throttle.hpp"
+#include "metrics/server_metrics.hpp"
+#include "model/blob_store.hpp"
+#include "model/resource.hpp"
+#include "model/verified_digest.hpp"
 #include "oatpp/Types.hpp"
 #include "utils/sha256.hpp"
 
@@ -40,115 +52,307 @@ BlobResourceProvider::get_resource_str(const std::string& resource) {
 
 BlobResourceProvider::BlobResourceProvider(
     std::filesystem::path blob_dir,
-    const std::string& base_url,
-    uint16_t port
+    const std::vector<MirrorConfig>& mirrors,
+    const DownloadConfig& download,
+    std::shared_ptr<BlobStore> blob_store,
+    std::shared_ptr<ServerMetrics> metrics
 ) :
     m_blob_dir(std::move(blob_dir)),
-    m_base_url(base_url),
-    m_port(port) {}
+    m_download(download),
+    // a mirror which keeps the connection open but sends nothing fails the
+    // read after the stall timeout
+    m_mirrors(mirrors, std::chrono::seconds(download.stall_timeout_s)),
+    m_blob_store(std::move(blob_store)),
+    m_metrics(std::move(metrics)) {}
 
-bool valid_file_exists(const std::string& target, const std::string& resource) {
-    std::ifstream stream(target, std::ifstream::in | std::ifstream::binary);
+bool valid_file_exists(
+    const std::string& target,
+    const std::string& resource,
+    const PullOptions& options
+) {
+    // trust an earlier verification as long as the file wasn't touched since
+    if (!options.verify && is_verified(target, resource)) {
+        return true;
+    }
 
-    if (stream) {
-        // file opened successfully -> file already exists; checking hash
-        if (SHA256Hasher::hash(stream) == resource) {
+    std::error_code error_code;
+    if (fs::is_regular_file(target, error_code)) {
+        // file already exists; checking hash
+        if (SHA256Hasher::hash_file(target) == resource) {
+            record_verified(target, resource);
             return true;
         }
-        stream.close();
         // hash mismatch -> delete file
         fs::remove(target);
+        forget_verified(target);
     }
     return false;
 }
 
-std::shared_ptr<oatpp::web::protocol::http::incoming::Response>
-BlobResourceProvider::request_download_file(
+std::string BlobResourceProvider::download_file(
     const std::string& target,
-    const std::string& source
+    const std::string& resource,
+    const std::shared_ptr<InFlightDownload>& download
 ) {
-    /* create connection provider */
-    auto config = oatpp::openssl::Config::createDefaultClientConfigShared();
-    auto connectionProvider =
-        oatpp::openssl::client::ConnectionProvider::createShared(
-            config,
-            {m_base_url, m_port}
-        );
-
-    /* create HTTP request executor */
-    auto requestExecutor =
-        oatpp::web::client::HttpRequestExecutor::createShared(
-            connectionProvider
-        );
-
-    /* create JSON object mapper */
-    auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+    const auto mirrors = m_mirrors.ranked("sha256_"s + resource);
+    if (const auto digest =
+            download_segmented(target, resource, mirrors, download)) {
+        return *digest;
+    }
+    // every mirror gets a chance
+    const auto max_attempts = std::max<size_t>(
+        config::download_max_attempts,
+        mirrors.size()
+    );
+    for (size_t attempt = 1;; ++attempt) {
+        const auto& mirror = *mirrors[(attempt - 1) % mirrors.size()];
+        try {
+            return download_attempt(target, resource, mirror, download);
+        } catch (const DownloadCancelled&) {
+            throw;
+        } catch (const std::exception& e) {
+            if (attempt >= max_attempts) {
+                throw;
+            }
+            // the partial file is kept, the next attempt continues from it
+            // on the next mirror
+            OATPP_LOGw(
+                "BlobResourceProvider",
+                "download of {} from {} failed (attempt {}): {}",
+                resource,
+                mirror.name(),
+                attempt,
+                e.what()
+            );
+        }
+        // only wait before going back to a mirror which already failed
+        if (attempt % mirrors.size() == 0) {
+            std::this_thread::sleep_for(config::download_retry_delay);
+        }
+    }
+}
 
-    /* create API client */
-    auto client = DownloadClient::createShared(requestExecutor, objectMapper);
+std::optional<std::string> BlobResourceProvider::download_segmented(
+    const std::string& target,
+    const std::string& resource,
+    const std::vector<std::shared_ptr<Mirror>>& mirrors,
+    const std::shared_ptr<InFlightDownload>& download
+) {
+    // a segmented download left behind continues, even with one connection
+    const auto resumable = SegmentMap::exists(target);
+    if (m_download.connections <= 1 && !resumable) {
+        return std::nullopt;
+    }
+    std::error_code error_code;
+    if (!resumable && fs::file_size(target, error_code) > 0 && !error_code) {
+        // an interrupted single stream download is resumed instead
+        return std::nullopt;
+    }
 
-    return client->getDownload(source);
+    const auto source = "sha256_"s + resource;
+    SegmentedDownload segmented(
+        [&mirrors, source](const std::string& range, int attempt) {
+            const auto& mirror = mirrors[(attempt - 1) % mirrors.size()];
+            return mirror->request(source, range);
+        },
+        resource,
+        download,
+        m_download
+    );
+    std::optional<std::string> digest;
+    try {
+        digest = segmented.run(target);
+    } catch (const DownloadCancelled&) {
+        throw;
+    } catch (const std::exception& e) {
+        // every segment already failed over between the mirrors, the next
+        // pull continues with the missing segments
+        OATPP_LOGw(
+            "BlobResourceProvider",
+            "segmented download of {} failed, keeping it to resume: {}",
+            resource,
+            e.what()
+        );
+        throw;
+    }
+    if (!digest && resumable) {
+        // the single stream path can't continue around the holes
+        fs::remove(target, error_code);
+        SegmentMap::remove(target);
+    }
+    return digest;
 }
 
-void BlobResourceProvider::download_file(
+std::string BlobResourceProvider::download_attempt(
     const std::string& target,
-    const std::string& source
+    const std::string& resource,
+    Mirror& mirror,
+    const std::shared_ptr<InFlightDownload>& download
 ) {
-    auto response = request_download_file(target, source);
-    auto output_stream = oatpp::data::stream::FileOutputStream(target.c_str());
-    response->transferBodyToStream(&output_stream);
-}
+    using Status = oatpp::web::protocol::http::Status;
 
-void BlobResourceProvider::pull_resource(const std::string& resource) {
-    const auto target = get_resource_str(resource);
-    if (valid_file_exists(target, resource)) {
-        return;
+    const auto source = "sha256_"s + resource;
+    std::error_code error_code;
+    auto offset = static_cast<int64_t>(fs::file_size(target, error_code));
+    if (error_code) {
+        offset = 0;
     }
 
-    auto target_temp_path = target + ".tmp";
-    download_file(target_temp_path, "sha256_"s + resource);
-    fs::rename(target_temp_path, target);
+    auto response = mirror.request(
+        source,
+        offset > 0 ? "bytes=" + std::to_string(offset) + "-" : ""
+    );
+    if (offset > 0 && response->getStatusCode() != Status::CODE_206.code) {
+        // range ignored or not satisfiable -> start from scratch
+        OATPP_LOGi(
+            "BlobResourceProvider",
+            "cannot resume {}, downloading from the start",
+            resource
+        );
+        offset = 0;
+        if (response->getStatusCode() != Status::CODE_200.code) {
+            discard_response(response);
+            response = mirror.request(source, "");
+        }
+    }
+    if (response->getStatusCode() != Status::CODE_200.code
+        && response->getStatusCode() != Status::CODE_206.code) {
+        discard_response(response);
+        throw std::runtime_error(
+            "download failed with status "
+            + std::to_string(response->getStatusCode())
+        );
+    }
 
-    std::ifstream stream(target, std::ifstream::in | std::ifstream::binary);
-    if (SHA256Hasher::hash(stream) != resource) {
-        throw std::runtime_error("bad hash");
+    SHA256Hasher hasher;
+    if (offset > 0) {
+        // the partial file is hashed once instead of keeping the hash state
+        hasher.update_file(target);
+    }
+    const auto content_length = std::stoll(
+        response->getHeader("Content-Length").getValue("-1")
+    );
+    const auto total = content_length >= 0 ? offset + content_length : -1;
+    auto output_stream = std::make_shared<OutputFileStream>(
+        target,
+        resource,
+        download,
+        offset,
+        total,
+        std::move(hasher),
+        m_download
+    );
+    // the blob is hashed while it's written -> no second pass over the file
+    try {
+        response->transferBody(output_stream);
+    } catch (...) {
+        // the data received so far is still written by the destructor
+        discard_response(response);
+        throw;
+    }
+    output_stream->close();
+    if (total >= 0 && output_stream->completed() < total) {
+        discard_response(response);
+        throw std::runtime_error("connection closed before the end of blob");
     }
+    return output_stream->finalize_digest();
 }
 
 void BlobResourceProvider::pull_resource(
     const std::string& resource,
-    const std::shared_ptr<PullReadCallback::EventQueue>& queue
+    const PullOptions& options
 ) {
-    const auto target = get_resource_str(resource);
-    if (valid_file_exists(target, resource)) {
-        queue->enqueue(PullEvent::PROGRESS, "success", "", -1, -1);
-        queue->enqueue(PullEvent::DONE, "", "", -1, -1);
-        return;
-    }
-
-    auto target_temp_path = target + ".tmp";
-    auto response =
-        request_download_file(target_temp_path, "sha256_"s + resource);
-    response->transferBody(
-        std::make_shared<OutputFileStream>(
-            target_temp_path.c_str(),
+    pull(resource, options, nullptr);
+}
+
+void BlobResourceProvider::pull_resource(
+    const std::string& resource,
+    const PullOptions& options,
+    const std::shared_ptr<PullProgressChannel>& channel
+) {
+    try {
+        pull(resource, options, channel);
+    } catch (const std::exception& e) {
+        // already sent to the channel
+        OATPP_LOGe(
+            "BlobResourceProvider",
+            "pull of {} failed: {}",
             resource,
-            queue,
-            response->getHeader("Content-Length").getValue("-1")
-        )
-    );
-    fs::rename(target_temp_path, target);
+            e.what()
+        );
+    }
+}
 
-    queue->enqueue(PullEvent::PROGRESS, "verifying sha256 digest", "", -1, -1);
-    std::ifstream stream(target, std::ifstream::in | std::ifstream::binary);
-    if (SHA256Hasher::hash(stream) != resource) {
-        throw std::runtime_error("bad hash");
+void BlobResourceProvider::pull(
+    const std::string& resource,
+    const PullOptions& options,
+    const std::shared_ptr<PullProgressChannel>& channel
+) {
+    const auto [download, owner] =
+        m_in_flight.join(resource, options.throttle);
+    if (!owner && (!options.throttle || !options.throttle->limits())) {
+        // somebody waits for it now
+        download->release_throttle();
+    }
+    download->subscribe(channel);
+    if (owner) {
+        run_download(resource, options, download);
+    }
+    download->wait();
+}
+
+void BlobResourceProvider::run_download(
+    const std::string& resource,
+    const PullOptions& options,
+    const std::shared_ptr<InFlightDownload>& download
+) {
+    const auto begin = std::chrono::steady_clock::now();
+    std::exception_ptr error;
+    try {
+        const auto target = get_resource_str(resource);
+        if (!valid_file_exists(target, resource, options)) {
+            auto target_temp_path = target + ".tmp";
+            const auto digest =
+                download_file(target_temp_path, resource, download);
+            download->status("verifying sha256 digest");
+            if (digest != resource) {
+                fs::remove(target_temp_path);
+                throw std::runtime_error("bad hash");
+            }
+            fs::rename(target_temp_path, target);
+            record_verified(target, resource);
+        }
+        if (m_blob_store) {
+            m_blob_store->added(resource);
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    // a blob which was already there doesn't count as a download
+    if (m_metrics && download->received() > 0) {
+        m_metrics->pull_finished(
+            static_cast<uint64_t>(download->received()),
+            std::chrono::steady_clock::now() - begin,
+            !error
+        );
     }
-    queue->enqueue(PullEvent::PROGRESS, "success", "", -1, -1);
-    queue->enqueue(PullEvent::DONE, "", "", -1, -1);
+    // a pull starting after this point checks the file again
+    m_in_flight.remove(resource);
+    download->finish(error);
 }
 
 std::filesystem::path
 BlobResourceProvider::get_resource(const std::string& resource) {
     return get_resource_str(resource);
 }
+
+bool BlobResourceProvider::remove_resource(const std::string& resource) {
+    const auto target = get_resource_str(resource);
+    forget_verified(target);
+    std::error_code error_code;
+    const auto removed = fs::remove(target, error_code);
+    if (m_blob_store) {
+        m_blob_store->removed(resource);
+    }
+    return !error_code && removed;
+}
@@ -11,36 +11,77 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
-#include <oatpp/web/protocol/http/incoming/Response.hpp>
-
-#include "controller/pull_callback.hpp"
+#include "config/runtime_config.hpp"
+#include "download/in_flight.hpp"
+#include "download/mirror.hpp"
+#include "download/progress_channel.hpp"
+#include "metrics/server_metrics.hpp"
+#include "model/blob_store.hpp"
 #include "model/resource.hpp"
 
 class BlobResourceProvider: public ResourceProvider {
   public:
     BlobResourceProvider(
         std::filesystem::path blob_dir,
-        const std::string& base_url,
-        uint16_t port
+        const std::vector<MirrorConfig>& mirrors,
+        const DownloadConfig& download = {},
+        std::shared_ptr<BlobStore> blob_store = nullptr,
+        std::shared_ptr<ServerMetrics> metrics = nullptr
     );
 
     std::filesystem::path get_resource(const std::string& resource) override;
-    void pull_resource(const std::string& resource) override;
+    void pull_resource(const std::string& resource, const PullOptions& options)
+        override;
     void pull_resource(
         const std::string& resource,
-        const std::shared_ptr<PullReadCallback::EventQueue>& queue
+        const PullOptions& options,
+        const std::shared_ptr<PullProgressChannel>& channel
     ) override;
+    bool remove_resource(const std::string& resource) override;
 
   private:
     std::string get_resource_str(const std::string& resource);
-    std::shared_ptr<oatpp::web::protocol::http::incoming::Response>
-    request_download_file(const std::string& target, const std::string& source);
-    void download_file(const std::string& target, const std::string& source);
+    // joins a download of the same resource if there is one in progress
+    void pull(
+        const std::string& resource,
+        const PullOptions& options,
+        const std::shared_ptr<PullProgressChannel>& channel
+    );
+    void run_download(
+        const std::string& resource,
+        const PullOptions& options,
+        const std::shared_ptr<InFlightDownload>& download
+    );
+    // returns the sha256 of the downloaded data, resumes after failures
+    std::string download_file(
+        const std::string& target,
+        const std::string& resource,
+        const std::shared_ptr<InFlightDownload>& download
+    );
+    // std::nullopt if the blob should be downloaded over a single stream
+    std::optional<std::string> download_segmented(
+        const std::string& target,
+        const std::string& resource,
+        const std::vector<std::shared_ptr<Mirror>>& mirrors,
+        const std::shared_ptr<InFlightDownload>& download
+    );
+    std::string download_attempt(
+        const std::string& target,
+        const std::string& resource,
+        Mirror& mirror,
+        const std::shared_ptr<InFlightDownload>& download
+    );
 
   private:
     std::filesystem::path m_blob_dir;
-    std::string m_base_url;
-    uint16_t m_port;
+    DownloadConfig m_download;
+    MirrorSet m_mirrors;
+    InFlightDownloads m_in_flight;
+    std::shared_ptr<BlobStore> m_blob_store;
+    std::shared_ptr<ServerMetrics> m_metrics;
 };
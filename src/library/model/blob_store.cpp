@@ -0,0 +1,328 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file blob_store.cpp
+ * @brief BlobStore implementation
+ **/
+
+#include "model/blob_store.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <oatpp/base/Log.hpp>
+
+#include "config/static_config.hpp"
+#include "model/verified_digest.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr std::string_view blob_prefix = "sha256_";
+constexpr std::string_view partial_suffix = ".tmp";
+
+bool ends_with(const std::string& value, std::string_view suffix) {
+    return value.size() >= suffix.size()
+        && value.compare(value.size() - suffix.size(), suffix.size(), suffix)
+        == 0;
+}
+}  // namespace
+
+BlobStore::Pin::Pin(BlobStore& store, std::string digest) :
+    m_store(&store),
+    m_digest(std::move(digest)) {
+    auto state = m_store->m_state.lock();
+    ++state->pinned[m_digest];
+}
+
+BlobStore::Pin::~Pin() {
+    if (m_store) {
+        m_store->unpin(m_digest);
+    }
+}
+
+BlobStore::Pin::Pin(Pin&& other) noexcept :
+    m_store(other.m_store),
+    m_digest(std::move(other.m_digest)) {
+    other.m_store = nullptr;
+}
+
+BlobStore::BlobStore(
+    fs::path blob_dir,
+    uint64_t quota_bytes,
+    ReferencedQuery referenced
+) :
+    m_blob_dir(std::move(blob_dir)),
+    m_quota_bytes(quota_bytes),
+    m_referenced(std::move(referenced)),
+    m_state(),
+    m_version(0) {
+    auto state = m_state.lock();
+    scan(*state);
+}
+
+fs::path BlobStore::blob_path(const std::string& digest) const {
+    return m_blob_dir / (std::string(blob_prefix) + digest);
+}
+
+std::optional<BlobStore::Entry>
+BlobStore::stat_blob(const std::string& digest) const {
+    const auto path = blob_path(digest);
+    std::error_code error_code;
+    const auto size = fs::file_size(path, error_code);
+    if (error_code) {
+        return std::nullopt;
+    }
+    auto last_used = fs::last_write_time(path, error_code);
+    if (error_code) {
+        return std::nullopt;
+    }
+    // the record is touched on every use, the blob itself never is
+    const auto record_time =
+        fs::last_write_time(verified_record_path(path), error_code);
+    if (!error_code) {
+        last_used = std::max(last_used, record_time);
+    }
+    return Entry {size, last_used};
+}
+
+void BlobStore::scan(State& state) const {
+    std::error_code error_code;
+    for (const auto& file : fs::directory_iterator(m_blob_dir, error_code)) {
+        const auto name = file.path().filename().string();
+        if (name.rfind(blob_prefix, 0) != 0 || ends_with(name, partial_suffix)
+            || ends_with(name, HAILO_VERIFIED_SUFFIX)) {
+            continue;
+        }
+        const auto digest = name.substr(blob_prefix.size());
+        const auto entry = stat_blob(digest);
+        if (!entry) {
+            continue;
+        }
+        state.entries[digest] = *entry;
+    }
+}
+
+void BlobStore::collect_garbage(bool remove_orphans) {
+    const auto now = fs::file_time_type::clock::now();
+    std::error_code error_code;
+    for (const auto& file : fs::directory_iterator(m_blob_dir, error_code)) {
+        const auto& path = file.path();
+        const auto name = path.filename().string();
+        std::error_code remove_error;
+        if (ends_with(name, partial_suffix)) {
+            // younger partial downloads are resumed by the next pull
+            const auto modified = fs::last_write_time(path, remove_error);
+            if (!remove_error
+                && now - modified > config::blob_stale_partial_age) {
+                OATPP_LOGi("BlobStore", "removing stale {}", name);
+                fs::remove(path, remove_error);
+            }
+        } else if (ends_with(name, HAILO_VERIFIED_SUFFIX)) {
+            auto blob = path;
+            blob.replace_extension();
+            if (!fs::exists(blob, remove_error)) {
+                fs::remove(path, remove_error);
+            }
+        }
+    }
+
+    const auto referenced = remove_orphans ? m_referenced() : DigestSet {};
+    auto state = m_state.lock();
+    if (remove_orphans && referenced.empty()) {
+        // most likely the manifests are missing, not every blob is an orphan
+        OATPP_LOGw(
+            "BlobStore",
+            "no manifests reference any blob, not removing orphans"
+        );
+    } else if (remove_orphans) {
+        std::vector<std::string> orphans;
+        for (const auto& [digest, entry] : state->entries) {
+            if (referenced.count(digest) == 0) {
+                orphans.push_back(digest);
+            }
+        }
+        for (const auto& digest : orphans) {
+            OATPP_LOGi("BlobStore", "removing orphaned blob {}", digest);
+            remove_blob(*state, digest);
+        }
+    }
+    enforce_quota(*state, {});
+}
+
+void BlobStore::touch(const std::string& digest) {
+    const auto now = fs::file_time_type::clock::now();
+    auto state = m_state.lock();
+    const auto it = state->entries.find(digest);
+    if (it == state->entries.end()) {
+        return;
+    }
+    it->second.last_used = now;
+    std::error_code error_code;
+    fs::last_write_time(
+        verified_record_path(blob_path(digest)),
+        now,
+        error_code
+    );
+}
+
+BlobStore::Pin BlobStore::pin(const std::string& digest) {
+    return Pin(*this, digest);
+}
+
+void BlobStore::loaded(const fs::path& model_path) {
+    const auto name = model_path.filename().string();
+    auto state = m_state.lock();
+    if (model_path.parent_path() == m_blob_dir
+        && name.rfind(blob_prefix, 0) == 0) {
+        state->loaded = name.substr(blob_prefix.size());
+    } else {
+        state->loaded.clear();
+    }
+}
+
+void BlobStore::unpin(const std::string& digest) {
+    auto state = m_state.lock();
+    const auto it = state->pinned.find(digest);
+    if (it != state->pinned.end() && --it->second == 0) {
+        state->pinned.erase(it);
+    }
+}
+
+void BlobStore::added(const std::string& digest) {
+    const auto entry = stat_blob(digest);
+    if (!entry) {
+        return;
+    }
+    auto state = m_state.lock();
+    state->entries[digest] = *entry;
+    ++m_version;
+    enforce_quota(*state, digest);
+}
+
+void BlobStore::removed(const std::string& digest) {
+    auto state = m_state.lock();
+    if (state->entries.erase(digest) > 0) {
+        ++m_version;
+    }
+}
+
+void BlobStore::rescan() {
+    auto state = m_state.lock();
+    auto entries = std::move(state->entries);
+    state->entries.clear();
+    scan(*state);
+    const auto same = [](const auto& first, const auto& second) {
+        return first.first == second.first;
+    };
+    if (!std::equal(
+            entries.begin(),
+            entries.end(),
+            state->entries.begin(),
+            state->entries.end(),
+            same
+        )) {
+        ++m_version;
+    }
+    enforce_quota(*state, {});
+}
+
+void BlobStore::set_quota(uint64_t quota_bytes) {
+    auto state = m_state.lock();
+    m_quota_bytes = quota_bytes;
+    enforce_quota(*state, {});
+}
+
+void BlobStore::enforce_quota(State& state, const std::string& keep) {
+    const uint64_t quota_bytes = m_quota_bytes;
+    if (quota_bytes == 0) {
+        return;
+    }
+    uint64_t used = 0;
+    std::vector<std::pair<fs::file_time_type, std::string>> candidates;
+    for (const auto& [digest, entry] : state.entries) {
+        used += entry.size;
+        if (digest != keep && digest != state.loaded
+            && state.pinned.count(digest) == 0) {
+            candidates.emplace_back(entry.last_used, digest);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto& [last_used, digest] : candidates) {
+        if (used <= quota_bytes) {
+            break;
+        }
+        used -= state.entries.at(digest).size;
+        OATPP_LOGi("BlobStore", "evicting least recently used {}", digest);
+        remove_blob(state, digest);
+    }
+    if (used > quota_bytes) {
+        OATPP_LOGw(
+            "BlobStore",
+            "{} bytes of blobs in use exceed the quota of {} bytes",
+            used,
+            quota_bytes
+        );
+    }
+}
+
+void BlobStore::remove_blob(State& state, const std::string& digest) {
+    const auto path = blob_path(digest);
+    forget_verified(path);
+    std::error_code error_code;
+    fs::remove(path, error_code);
+    if (error_code) {
+        OATPP_LOGw(
+            "BlobStore",
+            "failed to remove {}: {}",
+            path.string(),
+            error_code.message()
+        );
+    }
+    state.entries.erase(digest);
+    ++m_version;
+}
+
+BlobStoreUsage BlobStore::usage() {
+    BlobStoreUsage result {m_quota_bytes.load(), 0, 0, {}};
+    {
+        auto state = m_state.lock();
+        for (const auto& [digest, entry] : state->entries) {
+            result.used_bytes += entry.size;
+            result.blobs.push_back({digest, entry.size, entry.last_used});
+        }
+    }
+    std::sort(
+        result.blobs.begin(),
+        result.blobs.end(),
+        [](const BlobUsage& a, const BlobUsage& b) {
+            return a.last_used > b.last_used;
+        }
+    );
+
+    std::error_code error_code;
+    for (const auto& file : fs::directory_iterator(m_blob_dir, error_code)) {
+        if (ends_with(file.path().filename().string(), partial_suffix)) {
+            std::error_code size_error;
+            const auto size = file.file_size(size_error);
+            if (!size_error) {
+                result.temp_bytes += size;
+            }
+        }
+    }
+    return result;
+}
+
+uint64_t BlobStore::get_version() const {
+    return m_version;
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file blob_store.hpp
+ * @brief Disk usage of the blob directory
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <libguarded/cs_plain_guarded.h>
+
+struct BlobUsage {
+    std::string digest;
+    uint64_t size;
+    std::filesystem::file_time_type last_used;
+};
+
+struct BlobStoreUsage {
+    // 0 means unlimited
+    uint64_t quota_bytes;
+    uint64_t used_bytes;
+    // partial downloads, not counted in used_bytes
+    uint64_t temp_bytes;
+    // most recently used first
+    std::vector<BlobUsage> blobs;
+};
+
+/**
+ * Tracks the size and last use of every blob and keeps the directory under a
+ * quota by removing the least recently used blobs. The blob of the loaded
+ * model and the pinned ones, which requests are about to load, are never
+ * removed. The last use is kept as the modification time of the verification
+ * record, so the order survives restarts.
+ */
+class BlobStore {
+  public:
+    using DigestSet = std::set<std::string>;
+    // digests of the blobs referenced by manifests
+    using ReferencedQuery = std::function<DigestSet()>;
+
+    // keeps a blob from eviction while it's alive
+    class Pin {
+      public:
+        Pin(BlobStore& store, std::string digest);
+        ~Pin();
+        Pin(Pin&& other) noexcept;
+        Pin& operator=(Pin&& other) = delete;
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+      private:
+        BlobStore* m_store;
+        std::string m_digest;
+    };
+
+    BlobStore(
+        std::filesystem::path blob_dir,
+        uint64_t quota_bytes,
+        ReferencedQuery referenced
+    );
+
+    // removes stale partial downloads, verification records without a blob
+    // and, if requested, blobs which no manifest references
+    void collect_garbage(bool remove_orphans);
+
+    void touch(const std::string& digest);
+    // held from before a request takes the device until its model is loaded
+    Pin pin(const std::string& digest);
+    // called by the generation context whenever the loaded model changes
+    void loaded(const std::filesystem::path& model_path);
+    // a new blob -> may evict others to stay under the quota
+    void added(const std::string& digest);
+    void removed(const std::string& digest);
+    // picks up blobs another process added or removed, e.g. an import by the
+    // command line tool
+    void rescan();
+    // evicts right away if the blobs don't fit the new quota
+    void set_quota(uint64_t quota_bytes);
+
+    BlobStoreUsage usage();
+    // changes whenever a blob is added or removed
+    uint64_t get_version() const;
+
+  private:
+    struct Entry {
+        uint64_t size;
+        std::filesystem::file_time_type last_used;
+    };
+    struct State {
+        std::map<std::string, Entry> entries;
+        // pins by digest
+        std::map<std::string, size_t> pinned;
+        std::string loaded;
+    };
+
+    std::filesystem::path blob_path(const std::string& digest) const;
+    std::optional<Entry> stat_blob(const std::string& digest) const;
+    void scan(State& state) const;
+    void enforce_quota(State& state, const std::string& keep);
+    void remove_blob(State& state, const std::string& digest);
+    void unpin(const std::string& digest);
+
+  private:
+    std::filesystem::path m_blob_dir;
+    std::atomic<uint64_t> m_quota_bytes;
+    ReferencedQuery m_referenced;
+    libguarded::plain_guarded<State> m_state;
+    std::atomic<uint64_t> m_version;
+};
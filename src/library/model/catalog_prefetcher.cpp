@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file catalog_prefetcher.cpp
+ * @brief CatalogPrefetcher implementation
+ **/
+
+#include "model/catalog_prefetcher.hpp"
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <oatpp/base/Log.hpp>
+
+#include "config/static_config.hpp"
+#include "model/verified_digest.hpp"
+
+namespace {
+// from linux/ioprio.h, which older toolchains don't ship
+constexpr int ioprio_who_process = 1;
+constexpr int ioprio_class_idle = 3;
+constexpr int ioprio_class_shift = 13;
+
+// both are per thread on Linux and inherited by the segment download threads
+void lower_priority() {
+    const auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    (void)setpriority(PRIO_PROCESS, tid, config::catalog_prefetch_nice);
+    (void)syscall(
+        SYS_ioprio_set,
+        ioprio_who_process,
+        tid,
+        ioprio_class_idle << ioprio_class_shift
+    );
+}
+}  // namespace
+
+CatalogPrefetcher::CatalogPrefetcher(
+    const PrefetchConfig& config,
+    std::shared_ptr<ModelStore> model_store,
+    std::shared_ptr<ResourceProvider> resource_provider,
+    DownloadThrottle::PausePredicate paused
+) :
+    m_config(config),
+    m_model_store(std::move(model_store)),
+    m_resource_provider(std::move(resource_provider)),
+    m_paused(config.pause_while_generating ? std::move(paused) : nullptr),
+    m_stop(false),
+    m_thread(&CatalogPrefetcher::prefetch_loop, this) {}
+
+CatalogPrefetcher::~CatalogPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        if (m_throttle) {
+            m_throttle->cancel();
+        }
+    }
+    m_thread.join();
+}
+
+void CatalogPrefetcher::prefetch_loop() {
+    lower_priority();
+    const auto models =
+        m_config.all ? m_model_store->get_model_names() : m_config.models;
+    const auto begin = std::chrono::steady_clock::now();
+    for (const auto& name : models) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stop) {
+                return;
+            }
+        }
+        try {
+            prefetch_model(name);
+        } catch (const DownloadCancelled&) {
+            return;
+        } catch (const std::exception& e) {
+            // the model is pulled on first use instead
+            OATPP_LOGw(
+                "CatalogPrefetcher",
+                "prefetch of {} failed: {}",
+                name,
+                e.what()
+            );
+        }
+    }
+    OATPP_LOGi(
+        "CatalogPrefetcher",
+        "prefetched {} models in {} s",
+        models.size(),
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - begin
+        )
+            .count()
+    );
+}
+
+void CatalogPrefetcher::prefetch_model(const std::string& name) {
+    const auto summary = m_model_store->get_model_summary(name);
+    if (!summary) {
+        OATPP_LOGw("CatalogPrefetcher", "unknown model {}", name);
+        return;
+    }
+    const auto& resource = summary->hef_resource;
+    // a pull would count as a use of the blob for the quota
+    if (is_verified(m_resource_provider->get_resource(resource), resource)) {
+        return;
+    }
+
+    auto throttle = std::make_shared<DownloadThrottle>(
+        static_cast<uint64_t>(m_config.max_rate_kbps) * 1024,
+        m_paused
+    );
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop) {
+            return;
+        }
+        m_throttle = throttle;
+    }
+    OATPP_LOGi("CatalogPrefetcher", "prefetching {}", name);
+    PullOptions options;
+    options.throttle = std::move(throttle);
+    m_resource_provider->pull_resource(resource, options);
+}
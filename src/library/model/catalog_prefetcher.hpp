@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file catalog_prefetcher.hpp
+ * @brief Background pulls of catalog models at startup
+ **/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config/runtime_config.hpp"
+#include "download/throttle.hpp"
+#include "model/resource.hpp"
+#include "model/store.hpp"
+
+/**
+ * Pulls the configured models one after the other on a background thread
+ * with a low CPU and I/O priority. The downloads are limited to the
+ * configured rate and held while the pause predicate is true; a user pull of
+ * the same model joins the download and lifts both limits.
+ */
+class CatalogPrefetcher {
+  public:
+    CatalogPrefetcher(
+        const PrefetchConfig& config,
+        std::shared_ptr<ModelStore> model_store,
+        std::shared_ptr<ResourceProvider> resource_provider,
+        DownloadThrottle::PausePredicate paused
+    );
+    // cancels the download in progress
+    ~CatalogPrefetcher();
+
+    CatalogPrefetcher(const CatalogPrefetcher&) = delete;
+    CatalogPrefetcher& operator=(const CatalogPrefetcher&) = delete;
+
+  private:
+    void prefetch_loop();
+    void prefetch_model(const std::string& name);
+
+  private:
+    PrefetchConfig m_config;
+    std::shared_ptr<ModelStore> m_model_store;
+    std::shared_ptr<ResourceProvider> m_resource_provider;
+    DownloadThrottle::PausePredicate m_paused;
+    std::mutex m_mutex;
+    // a released throttle stays released -> a new one for every model
+    std::shared_ptr<DownloadThrottle> m_throttle;
+    bool m_stop;
+    std::thread m_thread;
+};
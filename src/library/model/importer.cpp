@@ -0,0 +1,403 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file importer.cpp
+ * @brief ModelImporter implementation
+ **/
+
+#include "model/importer.hpp"
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <oatpp/base/Log.hpp>
+
+#include "config/static_config.hpp"
+#include "download/blob_file_writer.hpp"
+#include "model/manifest.hpp"
+#include "model/verified_digest.hpp"
+#include "utils/path.hpp"
+#include "utils/sha256.hpp"
+#include "utils/split.hpp"
+#include "utils/tar.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr std::string_view blob_prefix = "sha256_";
+// ends with .tmp -> counted as a partial file by the blob store
+constexpr auto import_suffix = ".import.tmp";
+constexpr size_t sha256_hex_length = 64;
+
+bool is_digest(const std::string& value) {
+    return value.size() == sha256_hex_length
+        && value.find_first_not_of("0123456789abcdef") == std::string::npos;
+}
+
+bool is_path_component(const std::string& value) {
+    return !value.empty() && value != "." && value != ".."
+        && value.find('/') == std::string::npos;
+}
+
+std::vector<std::string> path_parts(const std::string& path) {
+    std::vector<std::string> parts;
+    for (const auto part : SplitRange(path, "/")) {
+        if (!part.empty() && part != ".") {
+            parts.emplace_back(part);
+        }
+    }
+    return parts;
+}
+
+bool same_filesystem(const fs::path& first, const fs::path& second) {
+    struct stat first_stat {};
+    struct stat second_stat {};
+    return stat(first.c_str(), &first_stat) == 0
+        && stat(second.c_str(), &second_stat) == 0
+        && first_stat.st_dev == second_stat.st_dev;
+}
+
+// shares the extents of source on filesystems which support it
+bool reflink(const fs::path& source, const fs::path& target) {
+#ifdef FICLONE
+    const auto source_fd = open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (source_fd < 0) {
+        return false;
+    }
+    const auto target_fd =
+        open(target.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    const auto cloned =
+        target_fd >= 0 && ioctl(target_fd, FICLONE, source_fd) == 0;
+    if (target_fd >= 0) {
+        (void)close(target_fd);
+        if (!cloned) {
+            (void)unlink(target.c_str());
+        }
+    }
+    (void)close(source_fd);
+    return cloned;
+#else
+    (void)source;
+    (void)target;
+    return false;
+#endif
+}
+}  // namespace
+
+ModelImporter::ModelImporter(
+    fs::path blob_dir,
+    fs::path manifest_dir,
+    std::shared_ptr<BlobStore> blob_store
+) :
+    m_blob_dir(std::move(blob_dir)),
+    m_manifest_dir(std::move(manifest_dir)),
+    m_blob_store(std::move(blob_store)) {}
+
+fs::path ModelImporter::blob_path(const std::string& digest) const {
+    return m_blob_dir / (std::string(blob_prefix) + digest);
+}
+
+std::vector<std::string>
+ModelImporter::import(const fs::path& source, const ImportOptions& options) {
+    // all blobs are in place before any manifest becomes visible
+    const auto manifests = fs::is_directory(source)
+        ? import_directory(source, options)
+        : import_archive(source, options);
+    if (manifests.empty()) {
+        throw std::runtime_error("no models found in " + source.string());
+    }
+    std::vector<std::string> names;
+    for (const auto& manifest : manifests) {
+        names.push_back(install_manifest(manifest));
+        OATPP_LOGi("ModelImporter", "imported {}", names.back());
+    }
+    return names;
+}
+
+std::vector<ModelImporter::Manifest> ModelImporter::import_directory(
+    const fs::path& source,
+    const ImportOptions& options
+) {
+    const auto manifest_root = source / HAILO_MODEL_MANIFEST;
+    if (!fs::is_directory(manifest_root)) {
+        throw std::runtime_error(
+            "no " + std::string(HAILO_MODEL_MANIFEST) + " directory in "
+            + source.string()
+        );
+    }
+
+    std::vector<Manifest> manifests;
+    for (auto it = fs::recursive_directory_iterator(manifest_root);
+         it != fs::recursive_directory_iterator();
+         ++it) {
+        // <model>/<tag>/manifest.json
+        if (it.depth() != 2 || !it->is_regular_file()
+            || !is_manifest_file(it->path())) {
+            continue;
+        }
+        const auto name = manifest_model_name(it->path());
+        std::ifstream stream(it->path());
+        std::stringstream content;
+        content << stream.rdbuf();
+        const auto digest = parse_manifest(name, content.str()).hef_resource;
+        if (!is_digest(digest)) {
+            throw std::runtime_error("invalid blob digest in " + name);
+        }
+
+        if (!is_verified(blob_path(digest), digest)) {
+            const auto source_blob = source / HAILO_BLOB_DIR_NAME
+                / (std::string(blob_prefix) + digest);
+            if (!fs::is_regular_file(source_blob)) {
+                throw std::runtime_error(
+                    "blob of " + name + " is missing from the bundle"
+                );
+            }
+            if (same_filesystem(source_blob, m_blob_dir)) {
+                if (hash_file(source_blob, digest, options) != digest) {
+                    throw std::runtime_error("bad hash for blob of " + name);
+                }
+                link_blob(source_blob, digest, options);
+            } else {
+                copy_file(source_blob, digest, options);
+            }
+        }
+        manifests.emplace_back(name, content.str());
+    }
+    return manifests;
+}
+
+std::vector<ModelImporter::Manifest> ModelImporter::import_archive(
+    const fs::path& source,
+    const ImportOptions& options
+) {
+    std::ifstream stream(source, std::ifstream::in | std::ifstream::binary);
+    if (!stream) {
+        throw std::runtime_error("Failed to open " + source.string());
+    }
+    TarReader archive(stream);
+    const auto reader = [&archive](char* data, size_t size) {
+        return archive.read(data, size);
+    };
+
+    // manifests may come before their blobs -> installed at the end
+    std::vector<Manifest> manifests;
+    while (const auto entry = archive.next()) {
+        if (!entry->regular) {
+            continue;
+        }
+        const auto parts = path_parts(entry->path);
+        const auto count = parts.size();
+        if (count >= 4 && parts[count - 4] == HAILO_MODEL_MANIFEST
+            && parts[count - 1] == HAILO_MANIFEST_FILE_NAME) {
+            std::string content(entry->size, '\0');
+            size_t offset = 0;
+            while (offset < content.size()) {
+                offset += archive.read(
+                    content.data() + offset,
+                    content.size() - offset
+                );
+            }
+            manifests.emplace_back(
+                parts[count - 3] + ":" + parts[count - 2],
+                std::move(content)
+            );
+        } else if (count >= 2 && parts[count - 2] == HAILO_BLOB_DIR_NAME
+                   && parts[count - 1].rfind(blob_prefix, 0) == 0) {
+            const auto digest = parts[count - 1].substr(blob_prefix.size());
+            if (!is_digest(digest)) {
+                OATPP_LOGw("ModelImporter", "skipping {}", entry->path);
+                continue;
+            }
+            if (!is_verified(blob_path(digest), digest)) {
+                copy_blob(reader, entry->size, digest, options);
+            }
+        }
+    }
+    return manifests;
+}
+
+void ModelImporter::link_blob(
+    const fs::path& source,
+    const std::string& digest,
+    const ImportOptions& options
+) {
+    const auto target = blob_path(digest);
+    std::error_code error_code;
+    if (options.move) {
+        fs::rename(source, target, error_code);
+        if (!error_code) {
+            blob_placed(digest);
+            return;
+        }
+    }
+
+    auto temp = target;
+    temp += import_suffix;
+    fs::remove(temp, error_code);
+    // a hard link shares the inode with the bundle: a later change to the
+    // bundle's file fails verification instead of going unnoticed
+    if (reflink(source, temp) || link(source.c_str(), temp.c_str()) == 0) {
+        fs::rename(temp, target);
+        blob_placed(digest);
+        return;
+    }
+    // no reflink or hard link support
+    copy_file(source, digest, options);
+}
+
+void ModelImporter::read_file(
+    const fs::path& source,
+    const std::function<void(const Reader&, uint64_t)>& use
+) {
+    const auto fd = open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(
+            errno,
+            std::generic_category(),
+            "Failed to open " + source.string()
+        );
+    }
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    const auto reader = [fd, &source](char* data, size_t size) {
+        const auto count = ::read(fd, data, size);
+        if (count < 0) {
+            throw std::system_error(
+                errno,
+                std::generic_category(),
+                "Failed to read " + source.string()
+            );
+        }
+        return static_cast<size_t>(count);
+    };
+    try {
+        use(reader, fs::file_size(source));
+    } catch (...) {
+        (void)close(fd);
+        throw;
+    }
+    (void)close(fd);
+}
+
+std::string ModelImporter::hash_file(
+    const fs::path& source,
+    const std::string& digest,
+    const ImportOptions& options
+) {
+    SHA256Hasher hasher;
+    read_file(source, [&](const Reader& reader, uint64_t size) {
+        std::vector<char> buffer(config::hash_buffer_size);
+        uint64_t completed = 0;
+        for (auto count = reader(buffer.data(), buffer.size()); count > 0;
+             count = reader(buffer.data(), buffer.size())) {
+            hasher.update(buffer.data(), count);
+            completed += count;
+            if (options.progress) {
+                options.progress(digest, size, completed);
+            }
+        }
+    });
+    return hasher.finalize();
+}
+
+void ModelImporter::copy_file(
+    const fs::path& source,
+    const std::string& digest,
+    const ImportOptions& options
+) {
+    read_file(source, [&](const Reader& reader, uint64_t size) {
+        copy_blob(reader, size, digest, options);
+    });
+}
+
+void ModelImporter::copy_blob(
+    const Reader& reader,
+    uint64_t size,
+    const std::string& digest,
+    const ImportOptions& options
+) {
+    const auto target = blob_path(digest);
+    auto temp = target;
+    temp += import_suffix;
+    SHA256Hasher hasher;
+    try {
+        BlobFileWriter writer(temp.string(), 0, true, false);
+        writer.reserve(static_cast<int64_t>(size));
+        std::vector<char> buffer(config::hash_buffer_size);
+        uint64_t completed = 0;
+        for (auto count = reader(buffer.data(), buffer.size()); count > 0;
+             count = reader(buffer.data(), buffer.size())) {
+            hasher.update(buffer.data(), count);
+            writer.write(buffer.data(), count);
+            completed += count;
+            if (options.progress) {
+                options.progress(digest, size, completed);
+            }
+        }
+        writer.close();
+        if (hasher.finalize() != digest) {
+            throw std::runtime_error("bad hash for blob " + digest);
+        }
+    } catch (...) {
+        std::error_code error_code;
+        fs::remove(temp, error_code);
+        throw;
+    }
+    fs::rename(temp, target);
+    blob_placed(digest);
+}
+
+void ModelImporter::blob_placed(const std::string& digest) {
+    record_verified(blob_path(digest), digest);
+    if (m_blob_store) {
+        m_blob_store->added(digest);
+    }
+}
+
+std::string ModelImporter::install_manifest(const Manifest& manifest) {
+    const auto& [name, content] = manifest;
+    const auto colon = name.find(':');
+    const auto model = name.substr(0, colon);
+    const auto tag = name.substr(colon + 1);
+    if (!is_path_component(model) || !is_path_component(tag)) {
+        throw std::runtime_error("invalid model name " + name);
+    }
+    const auto digest = parse_manifest(name, content).hef_resource;
+    if (!is_digest(digest) || !is_verified(blob_path(digest), digest)) {
+        throw std::runtime_error("blob of " + name + " is missing");
+    }
+
+    const auto dir = m_manifest_dir / model / tag;
+    fs::create_directories(dir);
+    const auto target = dir / HAILO_MANIFEST_FILE_NAME;
+    auto temp = target;
+    temp += ".tmp";
+    {
+        std::ofstream stream(temp, std::ofstream::trunc);
+        stream << content;
+        if (!stream) {
+            throw std::runtime_error("Failed to write " + temp.string());
+        }
+    }
+    // the model store sees the whole manifest at once
+    fs::rename(temp, target);
+    return name;
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file importer.hpp
+ * @brief Importing models from a local bundle
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "model/blob_store.hpp"
+
+struct ImportOptions {
+    using Progress = std::function<
+        void(const std::string& digest, uint64_t total, uint64_t completed)>;
+
+    // move blobs out of a bundle directory instead of linking them
+    bool move = false;
+    // called while a blob is hashed or copied, may throw to abort the import
+    Progress progress;
+};
+
+/**
+ * Imports models from a directory or an uncompressed tar archive laid out
+ * like the models directory:
+ *
+ *   manifests/<model>/<tag>/manifest.json
+ *   blob/sha256_<digest>
+ *
+ * Every blob is verified against its digest before it's placed, and a
+ * manifest is installed only after its blob. Blobs of a directory on the same
+ * filesystem are read once for the digest and then moved, reflinked or hard
+ * linked; all others are hashed while they're copied.
+ */
+class ModelImporter {
+  public:
+    ModelImporter(
+        std::filesystem::path blob_dir,
+        std::filesystem::path manifest_dir,
+        std::shared_ptr<BlobStore> blob_store
+    );
+
+    // returns the names of the imported models, throws on failure
+    std::vector<std::string>
+    import(const std::filesystem::path& source, const ImportOptions& options);
+
+  private:
+    using Reader = std::function<size_t(char*, size_t)>;
+    // model name and manifest content
+    using Manifest = std::pair<std::string, std::string>;
+
+    std::vector<Manifest> import_directory(
+        const std::filesystem::path& source,
+        const ImportOptions& options
+    );
+    std::vector<Manifest> import_archive(
+        const std::filesystem::path& source,
+        const ImportOptions& options
+    );
+
+    // calls use with a reader of the file and its size
+    static void read_file(
+        const std::filesystem::path& source,
+        const std::function<void(const Reader&, uint64_t)>& use
+    );
+    static std::string hash_file(
+        const std::filesystem::path& source,
+        const std::string& digest,
+        const ImportOptions& options
+    );
+    void link_blob(
+        const std::filesystem::path& source,
+        const std::string& digest,
+        const ImportOptions& options
+    );
+    void copy_file(
+        const std::filesystem::path& source,
+        const std::string& digest,
+        const ImportOptions& options
+    );
+    void copy_blob(
+        const Reader& reader,
+        uint64_t size,
+        const std::string& digest,
+        const ImportOptions& options
+    );
+    void blob_placed(const std::string& digest);
+    std::string install_manifest(const Manifest& manifest);
+
+    std::filesystem::path blob_path(const std::string& digest) const;
+
+  private:
+    std::filesystem::path m_blob_dir;
+    std::filesystem::path m_manifest_dir;
+    std::shared_ptr<BlobStore> m_blob_store;
+};
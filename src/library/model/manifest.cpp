@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file manifest.cpp
+ * @brief Manifest parsing implementation
+ **/
+
+#include "model/manifest.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "model/store.hpp"
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+    TemplateParamsInfo,
+    chat_template,
+    bos_token,
+    eos_token
+)
+
+template<typename T>
+std::optional<T> optional_from_json(const json& parent, std::string_view key) {
+    auto j = parent.find(key);
+    if (j == parent.end()) {
+        return {};
+    }
+    if (j->is_null()) {
+        return {};
+    }
+    return {j->template get<T>()};
+}
+
+// partial specialization (full specialization works too)
+NLOHMANN_JSON_NAMESPACE_BEGIN
+
+template<>
+struct adl_serializer<GenerationParamsInfo> {
+    static void from_json(const json& j, GenerationParamsInfo& info) {
+        info.temperature = optional_from_json<float>(j, "temperature");
+        info.top_p = optional_from_json<float>(j, "top_p");
+        info.top_k = optional_from_json<float>(j, "top_k");
+        info.frequency_penalty =
+            optional_from_json<float>(j, "frequency_penalty");
+        const auto& stop_tokens = j.find("stop_tokens");
+        if (stop_tokens != j.end()) {
+            info.stop_tokens =
+                stop_tokens->template get<std::vector<std::string>>();
+        }
+    }
+};
+
+NLOHMANN_JSON_NAMESPACE_END
+
+ModelInfo model_from_json(const std::string& name, const json& j) {
+    const auto& template_params = j.at("template_params");
+    const auto& generation_params = j.find("generation_params");
+    GenerationParamsInfo generation_params_info = {};
+    if (generation_params != j.end()) {
+        generation_params_info =
+            generation_params->template get<GenerationParamsInfo>();
+    }
+    const auto& details = j.find("details");
+    std::string details_string = details != j.end() ? details->dump() : "";
+    return ModelInfo {
+        .name = name,
+        .hef_resource = j.at("hef_h10h").template get<std::string>(),
+        .template_params = template_params.template get<TemplateParamsInfo>(),
+        .generation_params = std::move(generation_params_info),
+        .details = std::move(details_string),
+    };
+}
+
+bool is_manifest_file(const fs::path& file_path) {
+    return file_path.filename() == HAILO_MANIFEST_FILE_NAME;
+}
+
+std::string manifest_model_name(const fs::path& file_path) {
+    auto model = file_path.parent_path().parent_path().filename().string();
+    auto tag = file_path.parent_path().filename().string();
+    return std::move(model) + ":" + std::move(tag);
+}
+
+ModelInfo load_manifest(const std::string& name, const fs::path& file_path) {
+    std::ifstream stream(file_path);
+    return model_from_json(name, json::parse(stream));
+}
+
+ModelInfo parse_manifest(const std::string& name, const std::string& content) {
+    return model_from_json(name, json::parse(content));
+}
+
+ManifestEntry::ManifestEntry(
+    std::string name,
+    fs::path file_path,
+    ModelSummary summary
+) :
+    m_name(std::move(name)),
+    m_path(std::move(file_path)),
+    m_summary(std::move(summary)),
+    m_parsed(),
+    m_info() {}
+
+ManifestEntry::ManifestEntry(fs::path file_path, ModelInfo info) :
+    m_name(info.name),
+    m_path(std::move(file_path)),
+    m_summary {info.hef_resource, info.details},
+    m_parsed(),
+    m_info(std::move(info)) {}
+
+const std::string& ManifestEntry::name() const {
+    return m_name;
+}
+
+const fs::path& ManifestEntry::path() const {
+    return m_path;
+}
+
+const ModelSummary& ManifestEntry::summary() const {
+    return m_summary;
+}
+
+const ModelInfo& ManifestEntry::info() const {
+    std::call_once(m_parsed, [this]() {
+        if (!m_info) {
+            m_info = load_manifest(m_name, m_path);
+        }
+    });
+    return *m_info;
+}
@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file manifest.hpp
+ * @brief Parsing of model manifest files
+ **/
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "model/store.hpp"
+
+// filesystem tree:
+// manifests (root)
+// |
+// |- model
+//   |- tag
+//      |- manifest.json
+constexpr auto HAILO_MANIFEST_FILE_NAME {"manifest.json"};
+
+bool is_manifest_file(const std::filesystem::path& file_path);
+
+// "model:tag" for the given manifest file
+std::string manifest_model_name(const std::filesystem::path& file_path);
+
+ModelInfo
+load_manifest(const std::string& name, const std::filesystem::path& file_path);
+// the manifest json given as a string, throws if it's malformed
+ModelInfo parse_manifest(const std::string& name, const std::string& content);
+
+/**
+ * A manifest file together with its parsed content. Entries created from the
+ * manifest index only know their summary and parse the file on first use.
+ */
+class ManifestEntry {
+  public:
+    ManifestEntry(
+        std::string name,
+        std::filesystem::path file_path,
+        ModelSummary summary
+    );
+    ManifestEntry(std::filesystem::path file_path, ModelInfo info);
+
+    [[nodiscard]] const std::string& name() const;
+    [[nodiscard]] const std::filesystem::path& path() const;
+    [[nodiscard]] const ModelSummary& summary() const;
+    // parses the manifest if needed, throws on failure
+    [[nodiscard]] const ModelInfo& info() const;
+
+  private:
+    std::string m_name;
+    std::filesystem::path m_path;
+    ModelSummary m_summary;
+    mutable std::once_flag m_parsed;
+    mutable std::optional<ModelInfo> m_info;
+};
+
+using ManifestMap = std::map<std::string, std::shared_ptr<const ManifestEntry>>;
@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file manifest_index.cpp
+ * @brief Manifest index serialization
+ **/
+
+#include "model/manifest_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include <oatpp/base/Log.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+// file layout (native endianness - the index never leaves the machine):
+// magic | version | count | count * (path name mtime_ns size hef details)
+// strings are stored as a uint32_t length followed by the bytes
+constexpr std::string_view index_magic = "HOMI";
+constexpr uint32_t index_version = 1;
+// an entry with empty strings: four lengths, mtime_ns and size
+constexpr size_t min_entry_size =
+    4 * sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint64_t);
+
+class Reader {
+  public:
+    explicit Reader(std::string_view data) : m_data(data) {}
+
+    template<typename T>
+    std::optional<T> read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (m_data.size() < sizeof(T)) {
+            return std::nullopt;
+        }
+        T value;
+        std::memcpy(&value, m_data.data(), sizeof(T));
+        m_data.remove_prefix(sizeof(T));
+        return value;
+    }
+
+    std::optional<std::string> read_string() {
+        const auto length = read<uint32_t>();
+        if (!length || m_data.size() < *length) {
+            return std::nullopt;
+        }
+        std::string value(m_data.substr(0, *length));
+        m_data.remove_prefix(*length);
+        return value;
+    }
+
+    size_t remaining() const {
+        return m_data.size();
+    }
+
+    std::optional<std::string_view> read_raw(size_t length) {
+        if (m_data.size() < length) {
+            return std::nullopt;
+        }
+        const auto value = m_data.substr(0, length);
+        m_data.remove_prefix(length);
+        return value;
+    }
+
+  private:
+    std::string_view m_data;
+};
+
+class Writer {
+  public:
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        m_data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write_string(std::string_view value) {
+        write(static_cast<uint32_t>(value.size()));
+        m_data.append(value);
+    }
+
+    void write_raw(std::string_view value) {
+        m_data.append(value);
+    }
+
+    const std::string& data() const {
+        return m_data;
+    }
+
+  private:
+    std::string m_data;
+};
+
+std::optional<ManifestIndex> parse_index(std::string_view data) {
+    Reader reader(data);
+    const auto magic = reader.read_raw(index_magic.size());
+    const auto version = reader.read<uint32_t>();
+    const auto count = reader.read<uint32_t>();
+    if (magic != index_magic || version != index_version || !count) {
+        return std::nullopt;
+    }
+    // a corrupt count must not size the reservation
+    if (*count > reader.remaining() / min_entry_size) {
+        return std::nullopt;
+    }
+
+    ManifestIndex index;
+    index.reserve(*count);
+    for (uint32_t i = 0; i < *count; ++i) {
+        auto path = reader.read_string();
+        auto name = reader.read_string();
+        const auto mtime_ns = reader.read<int64_t>();
+        const auto size = reader.read<uint64_t>();
+        auto hef_resource = reader.read_string();
+        auto details = reader.read_string();
+        if (!path || !name || !mtime_ns || !size || !hef_resource
+            || !details) {
+            return std::nullopt;
+        }
+        index.emplace(
+            std::move(*path),
+            ManifestIndexEntry {
+                .name = std::move(*name),
+                .mtime_ns = *mtime_ns,
+                .size = *size,
+                .summary = {std::move(*hef_resource), std::move(*details)},
+            }
+        );
+    }
+    return index;
+}
+}  // namespace
+
+ManifestIndex read_manifest_index(const fs::path& index_path) {
+    // a single read of the whole file, parsing happens in memory
+    std::ifstream stream(index_path, std::ifstream::binary);
+    if (!stream) {
+        return {};
+    }
+    const std::string data(
+        (std::istreambuf_iterator<char>(stream)),
+        std::istreambuf_iterator<char>()
+    );
+    auto index = parse_index(data);
+    if (!index) {
+        OATPP_LOGw(
+            "manifest_index",
+            "ignoring invalid index {}",
+            index_path.string()
+        );
+        return {};
+    }
+    return std::move(*index);
+}
+
+void write_manifest_index(
+    const fs::path& index_path,
+    const ManifestIndex& index
+) {
+    Writer writer;
+    writer.write_raw(index_magic);
+    writer.write(index_version);
+    writer.write(static_cast<uint32_t>(index.size()));
+    for (const auto& [path, entry] : index) {
+        writer.write_string(path);
+        writer.write_string(entry.name);
+        writer.write(entry.mtime_ns);
+        writer.write(entry.size);
+        writer.write_string(entry.summary.hef_resource);
+        writer.write_string(entry.summary.details);
+    }
+
+    std::error_code error_code;
+    fs::create_directories(index_path.parent_path(), error_code);
+    // write & rename so a concurrent reader never sees a partial index
+    auto temp_path = index_path;
+    temp_path += ".tmp";
+    {
+        std::ofstream stream(
+            temp_path,
+            std::ofstream::binary | std::ofstream::trunc
+        );
+        stream.write(writer.data().data(), writer.data().size());
+        if (!stream) {
+            OATPP_LOGw(
+                "manifest_index",
+                "failed to write {}",
+                temp_path.string()
+            );
+            return;
+        }
+    }
+    fs::rename(temp_path, index_path, error_code);
+    if (error_code) {
+        OATPP_LOGw(
+            "manifest_index",
+            "failed to write {}",
+            index_path.string()
+        );
+        fs::remove(temp_path, error_code);
+    }
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file manifest_index.hpp
+ * @brief On-disk cache of manifest summaries for fast startup
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+#include "model/store.hpp"
+
+struct ManifestIndexEntry {
+    std::string name;
+    int64_t mtime_ns;
+    uint64_t size;
+    ModelSummary summary;
+};
+
+// keyed by the manifest file path
+using ManifestIndex = std::unordered_map<std::string, ManifestIndexEntry>;
+
+// Returns an empty index if the file is missing or not valid
+ManifestIndex read_manifest_index(const std::filesystem::path& index_path);
+
+// Failures are ignored - the index is only a cache
+void write_manifest_index(
+    const std::filesystem::path& index_path,
+    const ManifestIndex& index
+);
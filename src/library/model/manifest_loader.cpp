@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file manifest_loader.cpp
+ * @brief load_manifests & ManifestWarmer implementation
+ **/
+
+#include "model/manifest_loader.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <oatpp/base/Log.hpp>
+
+#include "config/static_config.hpp"
+#include "model/manifest.hpp"
+#include "model/manifest_index.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+struct PendingManifest {
+    fs::path path;
+    ManifestIndexEntry index_entry;
+    std::optional<ModelInfo> info;
+};
+
+void parallel_for(size_t count, const std::function<void(size_t)>& function) {
+    const auto thread_count = std::min<size_t>(
+        count,
+        std::max(1U, std::thread::hardware_concurrency())
+    );
+    std::atomic<size_t> next = 0;
+    const auto worker = [&]() {
+        for (auto i = next++; i < count; i = next++) {
+            function(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (size_t i = 1; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+std::optional<ManifestIndexEntry> stat_manifest(const fs::path& file_path) {
+    struct stat file_stat {};
+    if (stat(file_path.c_str(), &file_stat) != 0) {
+        return std::nullopt;
+    }
+    return ManifestIndexEntry {
+        .name = manifest_model_name(file_path),
+        .mtime_ns = static_cast<int64_t>(file_stat.st_mtim.tv_sec)
+                * 1'000'000'000
+            + file_stat.st_mtim.tv_nsec,
+        .size = static_cast<uint64_t>(file_stat.st_size),
+        .summary = {},
+    };
+}
+}  // namespace
+
+ManifestMap load_manifests(const fs::path& root, const fs::path& index_path) {
+    const auto begin = std::chrono::steady_clock::now();
+    const auto index =
+        index_path.empty() ? ManifestIndex {} : read_manifest_index(index_path);
+
+    ManifestMap manifests;
+    ManifestIndex new_index;
+    std::vector<PendingManifest> pending;
+    std::error_code error_code;
+    for (const auto& dir_entry :
+         fs::recursive_directory_iterator(root, error_code)) {
+        if (!dir_entry.is_regular_file() || !is_manifest_file(dir_entry)) {
+            continue;
+        }
+        const auto& file_path = dir_entry.path();
+        auto index_entry = stat_manifest(file_path);
+        if (!index_entry) {
+            continue;
+        }
+
+        const auto indexed = index.find(file_path.string());
+        if (indexed != index.end()
+            && indexed->second.mtime_ns == index_entry->mtime_ns
+            && indexed->second.size == index_entry->size) {
+            manifests.emplace(
+                indexed->second.name,
+                std::make_shared<const ManifestEntry>(
+                    indexed->second.name,
+                    file_path,
+                    indexed->second.summary
+                )
+            );
+            new_index.emplace(indexed->first, indexed->second);
+            continue;
+        }
+        pending.push_back({file_path, std::move(*index_entry), std::nullopt});
+    }
+    const auto indexed_count = manifests.size();
+
+    parallel_for(pending.size(), [&pending](size_t i) {
+        auto& manifest = pending[i];
+        try {
+            manifest.info =
+                load_manifest(manifest.index_entry.name, manifest.path);
+        } catch (const std::exception& e) {
+            OATPP_LOGe(
+                "model_store",
+                "failed to load {}: {}",
+                manifest.path.string(),
+                e.what()
+            );
+        }
+    });
+
+    for (auto& manifest : pending) {
+        if (!manifest.info) {
+            continue;
+        }
+        manifest.index_entry.summary = {
+            manifest.info->hef_resource,
+            manifest.info->details,
+        };
+        const auto name = manifest.index_entry.name;
+        new_index.emplace(
+            manifest.path.string(),
+            std::move(manifest.index_entry)
+        );
+        manifests.emplace(
+            name,
+            std::make_shared<const ManifestEntry>(
+                manifest.path,
+                std::move(*manifest.info)
+            )
+        );
+    }
+
+    if (!index_path.empty()
+        && (!pending.empty() || new_index.size() != index.size())) {
+        write_manifest_index(index_path, new_index);
+    }
+
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - begin
+    );
+    OATPP_LOGi(
+        "model_store",
+        "loaded {} manifests in {} ms ({} from index, {} parsed)",
+        manifests.size(),
+        duration.count(),
+        indexed_count,
+        manifests.size() - indexed_count
+    );
+    return manifests;
+}
+
+ManifestWarmer::ManifestWarmer(const ManifestMap& manifests) :
+    m_entries(),
+    m_next(0),
+    m_stop(false),
+    m_threads() {
+    m_entries.reserve(manifests.size());
+    for (const auto& [name, entry] : manifests) {
+        m_entries.push_back(entry);
+    }
+    const auto thread_count =
+        std::min(m_entries.size(), config::manifest_warmup_threads);
+    for (size_t i = 0; i < thread_count; ++i) {
+        m_threads.emplace_back(&ManifestWarmer::warm, this);
+    }
+}
+
+ManifestWarmer::~ManifestWarmer() {
+    m_stop = true;
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ManifestWarmer::warm() {
+    for (auto i = m_next++; i < m_entries.size() && !m_stop; i = m_next++) {
+        try {
+            (void)m_entries[i]->info();
+        } catch (const std::exception& e) {
+            // reported again when the model is requested
+            OATPP_LOGe(
+                "model_store",
+                "failed to load {}: {}",
+                m_entries[i]->path().string(),
+                e.what()
+            );
+        }
+    }
+}
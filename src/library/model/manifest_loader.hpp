@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file manifest_loader.hpp
+ * @brief Loading the manifests tree using the manifest index
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "model/manifest.hpp"
+
+/**
+ * Lists all manifests under root. Manifests found unchanged in the index are
+ * not parsed (see ManifestEntry), the rest are parsed in parallel and written
+ * back to the index. An empty index_path disables the index.
+ */
+ManifestMap load_manifests(
+    const std::filesystem::path& root,
+    const std::filesystem::path& index_path
+);
+
+/**
+ * Parses all lazy manifests on background threads so the first request for a
+ * model doesn't have to.
+ */
+class ManifestWarmer {
+  public:
+    explicit ManifestWarmer(const ManifestMap& manifests);
+    ~ManifestWarmer();
+
+    ManifestWarmer(const ManifestWarmer&) = delete;
+    ManifestWarmer& operator=(const ManifestWarmer&) = delete;
+
+  private:
+    void warm();
+
+    std::vector<std::shared_ptr<const ManifestEntry>> m_entries;
+    std::atomic<size_t> m_next;
+    std::atomic<bool> m_stop;
+    std::vector<std::thread> m_threads;
+};
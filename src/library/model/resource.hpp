@@ -10,17 +10,34 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string>
 
-#include "controller/pull_callback.hpp"
+#include "download/progress_channel.hpp"
+#include "download/throttle.hpp"
 #include "utils/interface.hpp"
 
+struct PullOptions {
+    // hash existing resources even if they were verified before
+    bool verify = false;
+    // limits a background pull; a pull without a limiting one joining the
+    // same download lifts the limit. Cancelling it stops a download the
+    // pull started
+    std::shared_ptr<DownloadThrottle> throttle;
+};
+
 class ResourceProvider: Interface {
   public:
     virtual std::filesystem::path get_resource(const std::string& resource) = 0;
-    virtual void pull_resource(const std::string& resource) = 0;
+    // concurrent pulls of the same resource share a single download; the
+    // variant with a channel reports errors there instead of throwing
+    virtual void
+    pull_resource(const std::string& resource, const PullOptions& options) = 0;
     virtual void pull_resource(
         const std::string& resource,
-        const std::shared_ptr<PullReadCallback::EventQueue>& queue
+        const PullOptions& options,
+        const std::shared_ptr<PullProgressChannel>& channel
     ) = 0;
+    // returns false if the resource didn't exist
+    virtual bool remove_resource(const std::string& resource) = 0;
 };
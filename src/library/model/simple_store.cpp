@@ -9,108 +9,46 @@
 
 #include "simple_store.hpp"
 
+#include <cstdint>
+#include <exception>
 #include <filesystem>
-#include <fstream>
 #include <optional>
 #include <string>
 #include <vector>
 
-#include <nlohmann/json.hpp>
+#include <oatpp/base/Log.hpp>
 
+#include "model/manifest.hpp"
+#include "model/manifest_loader.hpp"
 #include "model/store.hpp"
 
-using json = nlohmann::json;
 namespace fs = std::filesystem;
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
-    TemplateParamsInfo,
-    chat_template,
-    bos_token,
-    eos_token
-)
+SimpleModelStore::SimpleModelStore(
+    const fs::path& path,
+    const fs::path& index_path
+) :
+    m_models(load_manifests(path, index_path)),
+    m_warmer(m_models) {}
 
-template<typename T>
-std::optional<T> optional_from_json(const json& parent, std::string_view key) {
-    auto j = parent.find(key);
-    if (j == parent.end()) {
-        return {};
-    }
-    if (j->is_null()) {
-        return {};
-    }
-    return {j->template get<T>()};
-}
-
-// partial specialization (full specialization works too)
-NLOHMANN_JSON_NAMESPACE_BEGIN
-
-template<>
-struct adl_serializer<GenerationParamsInfo> {
-    static void from_json(const json& j, GenerationParamsInfo& info) {
-        info.temperature = optional_from_json<float>(j, "temperature");
-        info.top_p = optional_from_json<float>(j, "top_p");
-        info.top_k = optional_from_json<float>(j, "top_k");
-        info.frequency_penalty =
-            optional_from_json<float>(j, "frequency_penalty");
-        const auto& stop_tokens = j.find("stop_tokens");
-        if (stop_tokens != j.end()) {
-            info.stop_tokens =
-                stop_tokens->template get<std::vector<std::string>>();
-        }
-    }
-};
-
-NLOHMANN_JSON_NAMESPACE_END
-
-ModelInfo model_from_json(const std::string& name, const json& j) {
-    const auto& template_params = j.at("template_params");
-    const auto& generation_params = j.find("generation_params");
-    GenerationParamsInfo generation_params_info = {};
-    if (generation_params != j.end()) {
-        generation_params_info =
-            generation_params->template get<GenerationParamsInfo>();
+std::optional<ModelInfo> SimpleModelStore::get_model(const std::string& name) {
+    const auto model = m_models.find(name);
+    if (model == m_models.end()) {
+        return std::nullopt;
     }
-    const auto& details = j.find("details");
-    std::string details_string = details != j.end() ? details->dump() : "";
-    return ModelInfo {
-        .name = name,
-        .hef_resource = j.at("hef_h10h").template get<std::string>(),
-        .template_params = template_params.template get<TemplateParamsInfo>(),
-        .generation_params = std::move(generation_params_info),
-        .details = std::move(details_string),
-    };
-}
-
-SimpleModelStore::SimpleModelStore(const fs::path& path) : m_models() {
-    // filesystem tree:
-    // manifests (path variable)
-    // |
-    // |- model
-    //   |- tag
-    //      |- manifest.json
-    for (const auto& dir_entry : fs::recursive_directory_iterator(path)) {
-        // skip directories
-        if (!dir_entry.is_regular_file()) {
-            continue;
-        }
-
-        const auto& file_path = dir_entry.path();
-        auto model = file_path.parent_path().parent_path().filename().string();
-        auto tag = file_path.parent_path().filename().string();
-
-        std::ifstream stream(file_path);
-        const auto model_name = std::move(model) + ":" + std::move(tag);
-        m_models.emplace(
-            model_name,
-            model_from_json(model_name, json::parse(stream))
-        );
+    try {
+        return model->second->info();
+    } catch (const std::exception& e) {
+        OATPP_LOGe("model_store", "failed to load {}: {}", name, e.what());
+        return std::nullopt;
     }
 }
 
-std::optional<ModelInfo> SimpleModelStore::get_model(const std::string& name) {
+std::optional<ModelSummary>
+SimpleModelStore::get_model_summary(const std::string& name) {
     const auto model = m_models.find(name);
     if (model != m_models.end()) {
-        return model->second;
+        return model->second->summary();
     }
     return std::nullopt;
 }
@@ -123,3 +61,8 @@ std::vector<std::string> SimpleModelStore::get_model_names() {
     }
     return res;
 }
+
+uint64_t SimpleModelStore::get_version() {
+    // never changes after construction
+    return 0;
+}
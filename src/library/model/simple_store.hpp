@@ -9,23 +9,30 @@
 
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
-#include <map>
 #include <optional>
 #include <string>
 #include <vector>
 
-#include <nlohmann/json.hpp>
-
+#include "model/manifest.hpp"
+#include "model/manifest_loader.hpp"
 #include "model/store.hpp"
 
 class SimpleModelStore: public ModelStore {
   private:
-    std::map<std::string, ModelInfo> m_models;
+    ManifestMap m_models;
+    ManifestWarmer m_warmer;
 
   public:
-    explicit SimpleModelStore(const std::filesystem::path& path);
+    explicit SimpleModelStore(
+        const std::filesystem::path& path,
+        const std::filesystem::path& index_path = {}
+    );
 
     std::optional<ModelInfo> get_model(const std::string& name) override;
+    std::optional<ModelSummary>
+    get_model_summary(const std::string& name) override;
     std::vector<std::string> get_model_names() override;
+    uint64_t get_version() override;
 };
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -38,8 +39,19 @@ struct ModelInfo {
     std::string license;
 };
 
+// The part of ModelInfo needed for listing models
+struct ModelSummary {
+    std::string hef_resource;
+    std::string details;
+};
+
 class ModelStore: Interface {
   public:
     virtual std::optional<ModelInfo> get_model(const std::string& name) = 0;
+    // may avoid parsing the whole manifest
+    virtual std::optional<ModelSummary>
+    get_model_summary(const std::string& name) = 0;
     virtual std::vector<std::string> get_model_names() = 0;
+    // changes whenever the set of models or their contents change
+    virtual uint64_t get_version() = 0;
 };
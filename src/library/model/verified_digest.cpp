@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file verified_digest.cpp
+ * @brief Verified digest records implementation
+ **/
+
+#include "model/verified_digest.hpp"
+
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <system_error>
+
+#include <nlohmann/json.hpp>
+#include <oatpp/base/Log.hpp>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(FileIdentity, device, inode, size, mtime_ns)
+
+bool FileIdentity::operator==(const FileIdentity& other) const {
+    return device == other.device && inode == other.inode && size == other.size
+        && mtime_ns == other.mtime_ns;
+}
+
+std::optional<FileIdentity> file_identity(const fs::path& path) {
+    struct stat file_stat {};
+    if (stat(path.c_str(), &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+        return std::nullopt;
+    }
+    return FileIdentity {
+        .device = static_cast<uint64_t>(file_stat.st_dev),
+        .inode = static_cast<uint64_t>(file_stat.st_ino),
+        .size = static_cast<uint64_t>(file_stat.st_size),
+        .mtime_ns = static_cast<int64_t>(file_stat.st_mtim.tv_sec)
+                * 1'000'000'000
+            + file_stat.st_mtim.tv_nsec,
+    };
+}
+
+fs::path verified_record_path(const fs::path& blob) {
+    auto path = blob;
+    path += HAILO_VERIFIED_SUFFIX;
+    return path;
+}
+
+bool is_verified(const fs::path& blob, const std::string& digest) {
+    const auto identity = file_identity(blob);
+    if (!identity) {
+        return false;
+    }
+    std::ifstream stream(verified_record_path(blob));
+    if (!stream) {
+        return false;
+    }
+    try {
+        const auto record = json::parse(stream);
+        return record.at("sha256").get<std::string>() == digest
+            && record.at("file").get<FileIdentity>() == *identity;
+    } catch (const std::exception&) {
+        // corrupted record -> verify again
+        return false;
+    }
+}
+
+void record_verified(const fs::path& blob, const std::string& digest) {
+    const auto identity = file_identity(blob);
+    if (!identity) {
+        return;
+    }
+    const json record = {{"sha256", digest}, {"file", *identity}};
+    const auto record_path = verified_record_path(blob);
+    std::ofstream stream(record_path, std::ofstream::trunc);
+    stream << record.dump();
+    if (!stream) {
+        // not fatal - the blob will just be hashed again on the next pull
+        OATPP_LOGw(
+            "verified_digest",
+            "failed to write {}",
+            record_path.string()
+        );
+    }
+}
+
+void forget_verified(const fs::path& blob) {
+    std::error_code error_code;
+    fs::remove(verified_record_path(blob), error_code);
+}
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file verified_digest.hpp
+ * @brief Records of blobs whose digest was already verified
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+constexpr auto HAILO_VERIFIED_SUFFIX {".verified"};
+
+// Identifies the exact file contents a digest was verified for
+struct FileIdentity {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime_ns;
+
+    bool operator==(const FileIdentity& other) const;
+};
+
+std::optional<FileIdentity> file_identity(const std::filesystem::path& path);
+
+// The record is a sidecar file next to the blob (<blob>.verified)
+std::filesystem::path verified_record_path(const std::filesystem::path& blob);
+
+// true if digest was verified for the blob and the blob didn't change since
+bool is_verified(const std::filesystem::path& blob, const std::string& digest);
+
+void record_verified(
+    const std::filesystem::path& blob,
+    const std::string& digest
+);
+
+void forget_verified(const std::filesystem::path& blob);
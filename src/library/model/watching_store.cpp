@@ -0,0 +1,313 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file watching_store.cpp
+ * @brief WatchingModelStore implementation
+ **/
+
+#include "model/watching_store.hpp"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <oatpp/base/Log.hpp>
+
+#include "model/manifest.hpp"
+#include "model/manifest_loader.hpp"
+#include "model/store.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr uint32_t watch_mask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO
+    | IN_MOVED_FROM | IN_DELETE;
+constexpr size_t event_buffer_size = 16 * 1024;
+}  // namespace
+
+WatchingModelStore::WatchingModelStore(
+    const fs::path& path,
+    const fs::path& index_path
+) :
+    m_path(path),
+    m_models(),
+    m_version(0),
+    m_warmer(),
+    m_inotify_fd(inotify_init1(IN_CLOEXEC | IN_NONBLOCK)),
+    m_stop_fd(eventfd(0, EFD_CLOEXEC)) {
+    if (m_inotify_fd < 0 || m_stop_fd < 0) {
+        const auto error = errno;
+        (void)close(m_inotify_fd);
+        (void)close(m_stop_fd);
+        throw std::system_error(
+            error,
+            std::generic_category(),
+            "Failed to initialize manifest watcher"
+        );
+    }
+
+    // watches are added before the tree is listed -> no change is lost
+    watch_tree(m_path);
+    auto models =
+        std::make_shared<ManifestMap>(load_manifests(m_path, index_path));
+    m_warmer = std::make_unique<ManifestWarmer>(*models);
+    publish(std::move(models));
+
+    m_thread = std::thread(&WatchingModelStore::watch_loop, this);
+}
+
+WatchingModelStore::~WatchingModelStore() {
+    const uint64_t stop = 1;
+    (void)write(m_stop_fd, &stop, sizeof(stop));
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_warmer.reset();
+    (void)close(m_inotify_fd);
+    (void)close(m_stop_fd);
+}
+
+std::optional<ModelInfo> WatchingModelStore::get_model(const std::string& name
+) {
+    const auto models = snapshot();
+    const auto model = models->find(name);
+    if (model == models->end()) {
+        return std::nullopt;
+    }
+    try {
+        return model->second->info();
+    } catch (const std::exception& e) {
+        OATPP_LOGe("model_store", "failed to load {}: {}", name, e.what());
+        return std::nullopt;
+    }
+}
+
+std::optional<ModelSummary>
+WatchingModelStore::get_model_summary(const std::string& name) {
+    const auto models = snapshot();
+    const auto model = models->find(name);
+    if (model != models->end()) {
+        return model->second->summary();
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> WatchingModelStore::get_model_names() {
+    const auto models = snapshot();
+    std::vector<std::string> res;
+    res.reserve(models->size());
+    for (const auto& [model_name, model_info] : *models) {
+        res.push_back(model_name);
+    }
+    return res;
+}
+
+uint64_t WatchingModelStore::get_version() {
+    return m_version.load();
+}
+
+std::shared_ptr<const ManifestMap> WatchingModelStore::snapshot() const {
+    return std::atomic_load(&m_models);
+}
+
+void WatchingModelStore::set_listener(Listener listener) {
+    std::lock_guard<std::mutex> lock(m_listener_mutex);
+    m_listener = std::move(listener);
+}
+
+void WatchingModelStore::publish(std::shared_ptr<const ManifestMap> models) {
+    std::atomic_store(&m_models, std::move(models));
+    m_version.fetch_add(1);
+}
+
+void WatchingModelStore::watch_tree(const fs::path& dir) {
+    const auto add_watch = [this](const fs::path& path) {
+        const auto wd =
+            inotify_add_watch(m_inotify_fd, path.c_str(), watch_mask);
+        if (wd < 0) {
+            OATPP_LOGe("model_store", "failed to watch {}", path.string());
+            return;
+        }
+        m_watches[wd] = path;
+    };
+
+    add_watch(dir);
+    std::error_code error_code;
+    for (const auto& dir_entry :
+         fs::recursive_directory_iterator(dir, error_code)) {
+        if (dir_entry.is_directory()) {
+            add_watch(dir_entry.path());
+        }
+    }
+}
+
+bool WatchingModelStore::load_tree(const fs::path& dir, ManifestMap& models) {
+    bool changed = false;
+    std::error_code error_code;
+    for (const auto& dir_entry :
+         fs::recursive_directory_iterator(dir, error_code)) {
+        if (dir_entry.is_regular_file() && is_manifest_file(dir_entry)) {
+            changed |= update_file(dir_entry.path(), models);
+        }
+    }
+    return changed;
+}
+
+bool WatchingModelStore::update_file(
+    const fs::path& file_path,
+    ManifestMap& models
+) {
+    const auto model_name = manifest_model_name(file_path);
+    try {
+        models.insert_or_assign(
+            model_name,
+            std::make_shared<const ManifestEntry>(
+                file_path,
+                load_manifest(model_name, file_path)
+            )
+        );
+    } catch (const std::exception& e) {
+        // most likely a partially written file, the next event will fix it
+        OATPP_LOGe(
+            "model_store",
+            "failed to load {}: {}",
+            file_path.string(),
+            e.what()
+        );
+        return false;
+    }
+    OATPP_LOGi("model_store", "loaded model {}", model_name);
+    return true;
+}
+
+bool WatchingModelStore::remove_missing(ManifestMap& models) {
+    bool changed = false;
+    for (auto it = models.begin(); it != models.end();) {
+        std::error_code error_code;
+        if (fs::is_regular_file(it->second->path(), error_code)) {
+            ++it;
+            continue;
+        }
+        OATPP_LOGi("model_store", "removed model {}", it->first);
+        it = models.erase(it);
+        changed = true;
+    }
+    return changed;
+}
+
+bool WatchingModelStore::handle_events(
+    const char* buffer,
+    size_t size,
+    ManifestMap& models
+) {
+    bool changed = false;
+    for (size_t offset = 0; offset < size;) {
+        const auto* event =
+            reinterpret_cast<const inotify_event*>(buffer + offset);
+        offset += sizeof(inotify_event) + event->len;
+
+        if ((event->mask & IN_Q_OVERFLOW) != 0) {
+            // events were lost -> start over
+            models.clear();
+            watch_tree(m_path);
+            (void)load_tree(m_path, models);
+            changed = true;
+            continue;
+        }
+        if ((event->mask & IN_IGNORED) != 0) {
+            m_watches.erase(event->wd);
+            continue;
+        }
+        const auto watch = m_watches.find(event->wd);
+        if (watch == m_watches.end() || event->len == 0) {
+            continue;
+        }
+
+        const auto path = watch->second / event->name;
+        const auto added = (event->mask & (IN_CREATE | IN_MOVED_TO)) != 0;
+        const auto removed = (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0;
+        if ((event->mask & IN_ISDIR) != 0) {
+            if (added) {
+                watch_tree(path);
+                changed |= load_tree(path, models);
+            } else if (removed) {
+                changed |= remove_missing(models);
+            }
+            continue;
+        }
+        if (!is_manifest_file(path)) {
+            continue;
+        }
+        if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+            changed |= update_file(path, models);
+        } else if (removed) {
+            changed |= remove_missing(models);
+        }
+    }
+    return changed;
+}
+
+void WatchingModelStore::watch_loop() {
+    alignas(inotify_event) std::array<char, event_buffer_size> buffer {};
+    std::array<pollfd, 2> fds {{
+        {m_inotify_fd, POLLIN, 0},
+        {m_stop_fd, POLLIN, 0},
+    }};
+
+    while (true) {
+        const auto result = poll(fds.data(), fds.size(), -1);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            OATPP_LOGe("model_store", "poll failed, manifests are not watched");
+            return;
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            return;
+        }
+        if ((fds[0].revents & POLLIN) == 0) {
+            continue;
+        }
+
+        // copy-on-write: readers keep using the old map until publish()
+        auto models = std::make_shared<ManifestMap>(*snapshot());
+        bool changed = false;
+        while (true) {
+            const auto length =
+                read(m_inotify_fd, buffer.data(), buffer.size());
+            if (length <= 0) {
+                break;
+            }
+            changed |= handle_events(buffer.data(), length, *models);
+        }
+        if (changed) {
+            publish(std::move(models));
+            Listener listener;
+            {
+                std::lock_guard<std::mutex> lock(m_listener_mutex);
+                listener = m_listener;
+            }
+            if (listener) {
+                listener();
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file watching_store.hpp
+ * @brief Model store which follows manifest changes on disk
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "model/manifest.hpp"
+#include "model/manifest_loader.hpp"
+#include "model/store.hpp"
+
+/**
+ * Model store backed by inotify. Only the manifest files which changed are
+ * parsed again; every change publishes a new immutable model map, so lookups
+ * never wait for the watcher and callers keep the ModelInfo they already got.
+ */
+class WatchingModelStore: public ModelStore {
+  public:
+    using Listener = std::function<void()>;
+
+    explicit WatchingModelStore(
+        const std::filesystem::path& path,
+        const std::filesystem::path& index_path = {}
+    );
+    ~WatchingModelStore() override;
+
+    std::optional<ModelInfo> get_model(const std::string& name) override;
+    std::optional<ModelSummary>
+    get_model_summary(const std::string& name) override;
+    std::vector<std::string> get_model_names() override;
+    uint64_t get_version() override;
+    // called on the watcher thread after the manifests changed
+    void set_listener(Listener listener);
+
+  private:
+    void watch_loop();
+    bool handle_events(const char* buffer, size_t size, ManifestMap& models);
+    void watch_tree(const std::filesystem::path& dir);
+    bool load_tree(const std::filesystem::path& dir, ManifestMap& models);
+    bool update_file(
+        const std::filesystem::path& file_path,
+        ManifestMap& models
+    );
+    static bool remove_missing(ManifestMap& models);
+
+    std::shared_ptr<const ManifestMap> snapshot() const;
+    void publish(std::shared_ptr<const ManifestMap> models);
+
+  private:
+    std::filesystem::path m_path;
+    // accessed only with std::atomic_load/std::atomic_store
+    std::shared_ptr<const ManifestMap> m_models;
+    std::atomic<uint64_t> m_version;
+    std::unique_ptr<ManifestWarmer> m_warmer;
+    std::mutex m_listener_mutex;
+    Listener m_listener;
+
+    int m_inotify_fd;
+    int m_stop_fd;
+    // owned by the watcher thread after construction
+    std::map<int, std::filesystem::path> m_watches;
+    std::thread m_thread;
+};
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file server_connection.cpp
+ * @brief ServerConnection and ConnectionLimiter implementation
+ **/
+
+#include "network/server_connection.hpp"
+
+#include <poll.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "tracing/tracer.hpp"
+
+ConnectionLimiter::ConnectionLimiter(size_t max_connections) :
+    m_max_connections(max_connections),
+    m_active(0) {}
+
+bool ConnectionLimiter::try_acquire() {
+    auto active = m_active.load();
+    do {
+        if (m_max_connections != 0 && active >= m_max_connections) {
+            return false;
+        }
+    } while (!m_active.compare_exchange_weak(active, active + 1));
+    return true;
+}
+
+void ConnectionLimiter::release() {
+    --m_active;
+}
+
+size_t ConnectionLimiter::active() const {
+    return m_active;
+}
+
+ServerConnection::ServerConnection(
+    oatpp::v_io_handle handle,
+    std::chrono::seconds idle_timeout,
+    std::shared_ptr<ConnectionLimiter> limiter
+) :
+    oatpp::network::tcp::Connection(handle),
+    m_idle_timeout_ms(static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(idle_timeout)
+            .count()
+    )),
+    m_limiter(std::move(limiter)) {}
+
+ServerConnection::~ServerConnection() {
+    if (m_limiter) {
+        m_limiter->release();
+    }
+}
+
+oatpp::v_io_size ServerConnection::read(
+    void* buffer,
+    v_buff_size count,
+    oatpp::async::Action& action
+) {
+    if (m_idle_timeout_ms > 0) {
+        pollfd poll_fd {getHandle(), POLLIN, 0};
+        if (poll(&poll_fd, 1, m_idle_timeout_ms) == 0) {
+            // end of stream -> the handler closes the connection
+            return 0;
+        }
+    }
+    return oatpp::network::tcp::Connection::read(buffer, count, action);
+}
+
+oatpp::v_io_size ServerConnection::write(
+    const void* buffer,
+    v_buff_size count,
+    oatpp::async::Action& action
+) {
+    TRACE_SPAN("socket write");
+    return oatpp::network::tcp::Connection::write(buffer, count, action);
+}
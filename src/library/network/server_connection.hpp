@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file server_connection.hpp
+ * @brief Accepted connections with an idle timeout and a connection limit
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include <oatpp/network/tcp/Connection.hpp>
+
+/**
+ * Counts the open connections of all listeners against a common limit
+ */
+class ConnectionLimiter {
+  public:
+    // a zero limit is unlimited
+    explicit ConnectionLimiter(size_t max_connections);
+
+    bool try_acquire();
+    void release();
+    size_t active() const;
+
+  private:
+    const size_t m_max_connections;
+    std::atomic<size_t> m_active;
+};
+
+/**
+ * A connection which ends when no data arrived for the idle timeout while the
+ * handler waits for it, which is mostly a keep-alive connection waiting for
+ * its next request. Releases its place in the limiter when destroyed.
+ */
+class ServerConnection: public oatpp::network::tcp::Connection {
+  public:
+    // a zero timeout waits forever
+    ServerConnection(
+        oatpp::v_io_handle handle,
+        std::chrono::seconds idle_timeout,
+        std::shared_ptr<ConnectionLimiter> limiter
+    );
+    ~ServerConnection() override;
+
+    oatpp::v_io_size read(
+        void* buffer,
+        v_buff_size count,
+        oatpp::async::Action& action
+    ) override;
+    oatpp::v_io_size write(
+        const void* buffer,
+        v_buff_size count,
+        oatpp::async::Action& action
+    ) override;
+
+  private:
+    const int m_idle_timeout_ms;
+    std::shared_ptr<ConnectionLimiter> m_limiter;
+};
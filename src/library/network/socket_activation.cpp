@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file socket_activation.cpp
+ * @brief Socket activation implementation
+ **/
+
+#include "network/socket_activation.hpp"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace {
+// the first passed descriptor, SD_LISTEN_FDS_START in sd-daemon.h
+constexpr int listen_fds_start = 3;
+}  // namespace
+
+std::vector<int> activated_sockets() {
+    const auto* pid = std::getenv("LISTEN_PID");
+    const auto* count = std::getenv("LISTEN_FDS");
+    std::vector<int> sockets;
+    if (pid && count) {
+        try {
+            if (std::stol(pid) == static_cast<long>(getpid())) {
+                const auto fd_count = std::stoi(count);
+                for (int i = 0; i < fd_count; ++i) {
+                    const auto fd = listen_fds_start + i;
+                    (void)fcntl(fd, F_SETFD, FD_CLOEXEC);
+                    sockets.push_back(fd);
+                }
+            }
+        } catch (const std::exception&) {
+            // malformed -> not activated
+            sockets.clear();
+        }
+    }
+    (void)unsetenv("LISTEN_PID");
+    (void)unsetenv("LISTEN_FDS");
+    (void)unsetenv("LISTEN_FDNAMES");
+    return sockets;
+}
+
+int socket_family(int fd) {
+    sockaddr_storage address {};
+    socklen_t length = sizeof(address);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return -1;
+    }
+    return address.ss_family;
+}
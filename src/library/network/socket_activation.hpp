@@ -0,0 +1,19 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file socket_activation.hpp
+ * @brief Listening sockets passed by systemd socket activation
+ **/
+
+#pragma once
+
+#include <vector>
+
+// The sockets in LISTEN_FDS if LISTEN_PID is this process, empty otherwise.
+// The variables are removed, so child processes don't take them over.
+std::vector<int> activated_sockets();
+
+// AF_INET, AF_INET6 or AF_UNIX, -1 if it isn't a socket
+int socket_family(int fd);
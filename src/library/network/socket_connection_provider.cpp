@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file socket_connection_provider.cpp
+ * @brief SocketConnectionProvider implementation
+ **/
+
+#include "network/socket_connection_provider.hpp"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <oatpp/base/Log.hpp>
+#include <oatpp/network/tcp/Connection.hpp>
+
+#include "network/server_connection.hpp"
+
+namespace {
+// after an accept failing for lack of descriptors or memory the listening
+// socket stays readable, retrying at once would spin; a stopped provider
+// returns no connection at this rate until its server stops too
+constexpr int accept_retry_delay_ms = 100;
+
+constexpr std::string_view too_many_connections =
+    "HTTP/1.1 503 Service Unavailable\r\n"
+    "Content-Type: application/json\r\n"
+    "Content-Length: 32\r\n"
+    "Retry-After: 1\r\n"
+    "Connection: close\r\n"
+    "\r\n"
+    "{\"error\":\"too many connections\"}";
+
+// best effort - the client may not even read it
+void reject(int fd) {
+    (void)send(
+        fd,
+        too_many_connections.data(),
+        too_many_connections.size(),
+        MSG_NOSIGNAL | MSG_DONTWAIT
+    );
+    (void)shutdown(fd, SHUT_WR);
+    (void)close(fd);
+}
+}  // namespace
+
+SocketConnectionProvider::SocketConnectionProvider(ListenOptions options) :
+    m_options(std::move(options)),
+    m_fd(-1),
+    m_shared(false),
+    m_wakeup(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+    m_stopped(false),
+    m_invalidator(std::make_shared<ConnectionInvalidator>()) {
+    if (m_wakeup < 0) {
+        throw std::system_error(errno, std::generic_category(), "eventfd");
+    }
+}
+
+SocketConnectionProvider::~SocketConnectionProvider() {
+    stop();
+    // the server thread which called get() is done with it by now
+    if (m_fd >= 0) {
+        (void)close(m_fd);
+    }
+    (void)close(m_wakeup);
+}
+
+void SocketConnectionProvider::listen_on(int fd, bool shared) {
+    if (listen(fd, m_options.backlog) != 0) {
+        const auto error = errno;
+        (void)close(fd);
+        throw std::system_error(error, std::generic_category(), "listen");
+    }
+    m_fd = fd;
+    m_shared = shared;
+}
+
+void SocketConnectionProvider::prepare(int fd) {
+    (void)fd;
+}
+
+void SocketConnectionProvider::on_stop() {}
+
+oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>
+SocketConnectionProvider::get() {
+    pollfd poll_fds[] = {{m_fd, POLLIN, 0}, {m_wakeup, POLLIN, 0}};
+    while (!m_stopped) {
+        const auto ready = poll(poll_fds, 2, -1);
+        if (ready < 0 && errno != EINTR) {
+            return nullptr;
+        }
+        if (ready <= 0 || m_stopped) {
+            continue;
+        }
+        const auto fd = accept4(m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            const auto error = errno;
+            if (error == EMFILE || error == ENFILE || error == ENOBUFS
+                || error == ENOMEM) {
+                OATPP_LOGw(
+                    "SocketConnectionProvider",
+                    "accept failed: {}",
+                    std::strerror(error)
+                );
+                wait_for_stop(accept_retry_delay_ms);
+            }
+            // otherwise the client may be gone already, the server asks
+            // again
+            return nullptr;
+        }
+        if (m_options.limiter && !m_options.limiter->try_acquire()) {
+            reject(fd);
+            continue;
+        }
+        prepare(fd);
+        return oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(
+            std::make_shared<ServerConnection>(
+                fd,
+                m_options.idle_timeout,
+                m_options.limiter
+            ),
+            m_invalidator
+        );
+    }
+    // the server calls again right away until it's stopped as well
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(accept_retry_delay_ms)
+    );
+    return nullptr;
+}
+
+oatpp::async::CoroutineStarterForResult<
+    const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&>
+SocketConnectionProvider::getAsync() {
+    throw std::runtime_error(
+        "SocketConnectionProvider::getAsync() not implemented"
+    );
+}
+
+void SocketConnectionProvider::stop() {
+    if (m_stopped.exchange(true)) {
+        return;
+    }
+    const uint64_t wakeup = 1;
+    (void)write(m_wakeup, &wakeup, sizeof(wakeup));
+    // out of the accept queue and a SO_REUSEPORT group; a shared socket
+    // keeps listening for the process taking over
+    if (m_fd >= 0 && !m_shared) {
+        (void)shutdown(m_fd, SHUT_RDWR);
+    }
+    on_stop();
+}
+
+void SocketConnectionProvider::wait_for_stop(int timeout_ms) {
+    pollfd poll_fd {m_wakeup, POLLIN, 0};
+    (void)poll(&poll_fd, 1, timeout_ms);
+}
+
+void SocketConnectionProvider::ConnectionInvalidator::invalidate(
+    const std::shared_ptr<oatpp::data::stream::IOStream>& connection
+) {
+    // the connection closes the descriptor when it's destroyed
+    const auto server_connection =
+        std::static_pointer_cast<ServerConnection>(connection);
+    (void)shutdown(server_connection->getHandle(), SHUT_RDWR);
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file socket_connection_provider.hpp
+ * @brief Common part of the listening socket connection providers
+ **/
+
+#pragma once
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include <oatpp/network/ConnectionProvider.hpp>
+#include <oatpp/provider/Invalidator.hpp>
+
+#include "network/server_connection.hpp"
+
+struct ListenOptions {
+    int backlog = SOMAXCONN;
+    // zero waits forever
+    std::chrono::seconds idle_timeout {0};
+    // shared by all listeners, null for no limit
+    std::shared_ptr<ConnectionLimiter> limiter;
+};
+
+/**
+ * Accepts connections on a listening socket the subclass created. A
+ * connection above the limit gets a 503 response and is closed right away,
+ * instead of a thread being spawned for it.
+ *
+ * stop() wakes get() and stops listening, but the descriptor is only closed
+ * by the destructor: get() may still be using it on the server thread, and a
+ * closed number could be reused by another open meanwhile.
+ */
+class SocketConnectionProvider:
+    public oatpp::network::ServerConnectionProvider {
+  public:
+    ~SocketConnectionProvider() override;
+
+    oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>
+    get() override;
+    oatpp::async::CoroutineStarterForResult<
+        const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&>
+    getAsync() override;
+    void stop() override;
+
+  protected:
+    explicit SocketConnectionProvider(ListenOptions options);
+
+    // takes over a bound socket, closes it if listen() fails; a shared one,
+    // e.g. from systemd, is left listening by stop() for the other processes
+    void listen_on(int fd, bool shared = false);
+    // called for every accepted socket
+    virtual void prepare(int fd);
+    // called once by stop() after the socket stopped listening
+    virtual void on_stop();
+
+  private:
+    class ConnectionInvalidator:
+        public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+      public:
+        void invalidate(
+            const std::shared_ptr<oatpp::data::stream::IOStream>& connection
+        ) override;
+    };
+
+  private:
+    // returns early when stopped
+    void wait_for_stop(int timeout_ms);
+
+  private:
+    ListenOptions m_options;
+    int m_fd;
+    bool m_shared;
+    // readable once stopped, wakes get()
+    int m_wakeup;
+    std::atomic<bool> m_stopped;
+    std::shared_ptr<ConnectionInvalidator> m_invalidator;
+};
@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file tcp_connection_provider.cpp
+ * @brief TcpConnectionProvider implementation
+ **/
+
+#include "network/tcp_connection_provider.hpp"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "network/socket_connection_provider.hpp"
+
+namespace {
+void set_option(int fd, int level, int option, const char* name) {
+    const int enable = 1;
+    if (setsockopt(fd, level, option, &enable, sizeof(enable)) != 0) {
+        throw std::system_error(
+            errno,
+            std::generic_category(),
+            std::string("Failed to set ") + name
+        );
+    }
+}
+
+// binds the first address of host which works
+int bind_address(
+    const std::string& host,
+    uint16_t port,
+    const TcpListenOptions& options
+) {
+    addrinfo hints {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* addresses = nullptr;
+    const auto service = std::to_string(port);
+    const auto status =
+        getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses);
+    if (status != 0) {
+        throw std::runtime_error(
+            "Failed to resolve " + host + ": " + gai_strerror(status)
+        );
+    }
+
+    auto error = 0;
+    auto fd = -1;
+    for (auto* address = addresses; address && fd < 0;
+         address = address->ai_next) {
+        fd = socket(
+            address->ai_family,
+            address->ai_socktype | SOCK_CLOEXEC,
+            address->ai_protocol
+        );
+        if (fd < 0) {
+            error = errno;
+            continue;
+        }
+        try {
+            set_option(fd, SOL_SOCKET, SO_REUSEADDR, "SO_REUSEADDR");
+            if (options.reuse_port) {
+                set_option(fd, SOL_SOCKET, SO_REUSEPORT, "SO_REUSEPORT");
+            }
+        } catch (...) {
+            (void)close(fd);
+            freeaddrinfo(addresses);
+            throw;
+        }
+        if (bind(fd, address->ai_addr, address->ai_addrlen) != 0) {
+            error = errno;
+            (void)close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+        throw std::system_error(
+            error,
+            std::generic_category(),
+            "Failed to bind " + host + ":" + service
+        );
+    }
+    return fd;
+}
+}  // namespace
+
+TcpConnectionProvider::TcpConnectionProvider(
+    const std::string& host,
+    uint16_t port,
+    const TcpListenOptions& tcp_options,
+    const ListenOptions& options
+) :
+    SocketConnectionProvider(options),
+    m_tcp_options(tcp_options) {
+    listen_on(bind_address(host, port, m_tcp_options));
+}
+
+TcpConnectionProvider::TcpConnectionProvider(
+    int fd,
+    const TcpListenOptions& tcp_options,
+    const ListenOptions& options
+) :
+    SocketConnectionProvider(options),
+    m_tcp_options(tcp_options) {
+    listen_on(fd, true);
+}
+
+std::shared_ptr<TcpConnectionProvider> TcpConnectionProvider::createShared(
+    const std::string& host,
+    uint16_t port,
+    const TcpListenOptions& tcp_options,
+    const ListenOptions& options
+) {
+    return std::make_shared<TcpConnectionProvider>(
+        host,
+        port,
+        tcp_options,
+        options
+    );
+}
+
+void TcpConnectionProvider::prepare(int fd) {
+    if (m_tcp_options.no_delay) {
+        const int enable = 1;
+        // only costs latency if it fails
+        (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file tcp_connection_provider.hpp
+ * @brief Server connections over TCP with configurable socket options
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "network/socket_connection_provider.hpp"
+
+struct TcpListenOptions {
+    // send small writes, like streamed tokens, without waiting for more data
+    bool no_delay = true;
+    // several processes can listen on the same port
+    bool reuse_port = false;
+};
+
+/**
+ * Listens on a TCP address. Unlike the oatpp provider it takes the listen
+ * backlog and sets TCP_NODELAY on the accepted connections.
+ */
+class TcpConnectionProvider: public SocketConnectionProvider {
+  public:
+    TcpConnectionProvider(
+        const std::string& host,
+        uint16_t port,
+        const TcpListenOptions& tcp_options,
+        const ListenOptions& options = {}
+    );
+    // takes over a socket which is already bound, e.g. from systemd; it
+    // keeps listening after stop() for the other processes sharing it
+    TcpConnectionProvider(
+        int fd,
+        const TcpListenOptions& tcp_options,
+        const ListenOptions& options = {}
+    );
+
+    static std::shared_ptr<TcpConnectionProvider> createShared(
+        const std::string& host,
+        uint16_t port,
+        const TcpListenOptions& tcp_options,
+        const ListenOptions& options = {}
+    );
+
+  protected:
+    void prepare(int fd) override;
+
+  private:
+    TcpListenOptions m_tcp_options;
+};
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file unix_connection_provider.cpp
+ * @brief UnixSocketConnectionProvider implementation
+ **/
+
+#include "network/unix_connection_provider.hpp"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "network/socket_connection_provider.hpp"
+
+namespace {
+sockaddr_un make_address(const std::string& path) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("unix socket path too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+[[noreturn]] void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// a socket file nobody accepts on is left over from a previous run
+void remove_stale_socket(const std::string& path, const sockaddr_un& address) {
+    struct stat status {};
+    if (lstat(path.c_str(), &status) != 0 || !S_ISSOCK(status.st_mode)) {
+        return;
+    }
+    const auto fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw_errno("Failed to create unix socket");
+    }
+    const auto connected = connect(
+        fd,
+        reinterpret_cast<const sockaddr*>(&address),
+        sizeof(address)
+    );
+    (void)close(fd);
+    if (connected == 0) {
+        throw std::runtime_error("unix socket already in use: " + path);
+    }
+    (void)unlink(path.c_str());
+}
+}  // namespace
+
+UnixSocketConnectionProvider::UnixSocketConnectionProvider(
+    const std::string& path,
+    mode_t mode,
+    const ListenOptions& options
+) :
+    SocketConnectionProvider(options),
+    m_path(path) {
+    const auto address = make_address(m_path);
+    remove_stale_socket(m_path, address);
+
+    const auto fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw_errno("Failed to create unix socket");
+    }
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+        != 0) {
+        const auto error = errno;
+        (void)close(fd);
+        throw std::system_error(
+            error,
+            std::generic_category(),
+            "Failed to bind " + m_path
+        );
+    }
+    if (chmod(m_path.c_str(), mode) != 0) {
+        const auto error = errno;
+        (void)close(fd);
+        (void)unlink(m_path.c_str());
+        throw std::system_error(
+            error,
+            std::generic_category(),
+            "Failed to set the mode of " + m_path
+        );
+    }
+    try {
+        listen_on(fd);
+    } catch (...) {
+        (void)unlink(m_path.c_str());
+        throw;
+    }
+}
+
+UnixSocketConnectionProvider::UnixSocketConnectionProvider(
+    int fd,
+    const ListenOptions& options
+) :
+    SocketConnectionProvider(options) {
+    listen_on(fd, true);
+}
+
+UnixSocketConnectionProvider::~UnixSocketConnectionProvider() {
+    // the base destructor would not reach on_stop() of this class
+    stop();
+}
+
+std::shared_ptr<UnixSocketConnectionProvider>
+UnixSocketConnectionProvider::createShared(
+    const std::string& path,
+    mode_t mode,
+    const ListenOptions& options
+) {
+    return std::make_shared<UnixSocketConnectionProvider>(path, mode, options);
+}
+
+void UnixSocketConnectionProvider::on_stop() {
+    if (!m_path.empty()) {
+        (void)unlink(m_path.c_str());
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file unix_connection_provider.hpp
+ * @brief Server connections over a Unix domain socket
+ **/
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <memory>
+#include <string>
+
+#include "network/socket_connection_provider.hpp"
+
+/**
+ * Accepts connections on a Unix domain socket for clients on the same host,
+ * which skip the TCP stack. The connections are served by the same handler as
+ * TCP ones. A socket file left behind by a previous run is replaced, one a
+ * running server still listens on is not.
+ */
+class UnixSocketConnectionProvider: public SocketConnectionProvider {
+  public:
+    UnixSocketConnectionProvider(
+        const std::string& path,
+        mode_t mode,
+        const ListenOptions& options = {}
+    );
+    // takes over a socket which is already bound, e.g. from systemd; the
+    // socket file is left to its owner and it keeps listening after stop()
+    explicit UnixSocketConnectionProvider(
+        int fd,
+        const ListenOptions& options = {}
+    );
+    ~UnixSocketConnectionProvider() override;
+
+    static std::shared_ptr<UnixSocketConnectionProvider> createShared(
+        const std::string& path,
+        mode_t mode,
+        const ListenOptions& options = {}
+    );
+
+  protected:
+    // removes the socket file
+    void on_stop() override;
+
+  private:
+    // empty for an inherited socket
+    std::string m_path;
+};
@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file trace_interceptor.cpp
+ * @brief TraceInterceptor implementation
+ **/
+
+#include "tracing/trace_interceptor.hpp"
+
+#include <memory>
+
+#include "tracing/tracer.hpp"
+
+std::shared_ptr<TraceInterceptor::OutgoingResponse>
+TraceInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request) {
+    (void)request;
+    // even while disabled, so spans don't start at an older request when
+    // tracing is enabled in the middle of this one
+    tracing::Tracer::begin_request();
+    // continue to the endpoint
+    return nullptr;
+}
+
+std::shared_ptr<TraceInterceptor::OutgoingResponse> TraceInterceptor::intercept(
+    const std::shared_ptr<IncomingRequest>& request,
+    const std::shared_ptr<OutgoingResponse>& response
+) {
+    (void)request;
+    TRACE_SINCE_REQUEST("http request");
+    return response;
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file trace_interceptor.hpp
+ * @brief Starting a trace request for every HTTP request
+ **/
+
+#pragma once
+
+#include <memory>
+
+#include <oatpp/web/server/interceptor/RequestInterceptor.hpp>
+#include <oatpp/web/server/interceptor/ResponseInterceptor.hpp>
+
+/**
+ * Assigns the spans of the serving thread to the request which arrived, and
+ * records a span until its response headers are ready. Everything after that,
+ * e.g. a streamed body, has spans of its own.
+ */
+class TraceInterceptor:
+    public oatpp::web::server::interceptor::RequestInterceptor,
+    public oatpp::web::server::interceptor::ResponseInterceptor {
+  public:
+    // both bases declare them
+    using IncomingRequest = oatpp::web::protocol::http::incoming::Request;
+    using OutgoingResponse = oatpp::web::protocol::http::outgoing::Response;
+
+    std::shared_ptr<OutgoingResponse>
+    intercept(const std::shared_ptr<IncomingRequest>& request) override;
+    std::shared_ptr<OutgoingResponse> intercept(
+        const std::shared_ptr<IncomingRequest>& request,
+        const std::shared_ptr<OutgoingResponse>& response
+    ) override;
+};
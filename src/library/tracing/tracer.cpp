@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file tracer.cpp
+ * @brief Tracer implementation
+ **/
+
+#include "tracing/tracer.hpp"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "config/static_config.hpp"
+
+namespace tracing {
+
+namespace {
+struct RequestState {
+    uint64_t id = 0;
+    int64_t begin = 0;
+};
+
+thread_local RequestState current_request;
+
+int64_t thread_id() {
+    thread_local const auto id = static_cast<int64_t>(syscall(SYS_gettid));
+    return id;
+}
+
+double to_microseconds(int64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+}  // namespace
+
+std::atomic<bool> Tracer::s_enabled {false};
+
+Tracer::Tracer() :
+    m_capacity(config::trace_buffer_spans),
+    m_slots(std::make_unique<Slot[]>(m_capacity)),
+    m_next(0) {}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::set_enabled(bool enabled) {
+    if (enabled) {
+        // allocate the buffer before the first span
+        (void)instance();
+    }
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+int64_t Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+    )
+        .count();
+}
+
+void Tracer::begin_request() {
+    static std::atomic<uint64_t> next_request {1};
+    current_request.id = next_request.fetch_add(1, std::memory_order_relaxed);
+    current_request.begin = now();
+}
+
+int64_t Tracer::request_begin() {
+    return current_request.begin;
+}
+
+void Tracer::record(const char* name, int64_t begin, int64_t end) {
+    const auto index = m_next.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = m_slots[index % m_capacity];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.request.store(current_request.id, std::memory_order_relaxed);
+    slot.thread.store(thread_id(), std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.sequence.store(2 * (index + 1), std::memory_order_release);
+}
+
+std::string Tracer::chrome_trace() const {
+    auto events = nlohmann::json::array();
+    const auto pid = static_cast<int64_t>(getpid());
+    for (size_t i = 0; i < m_capacity; ++i) {
+        const auto& slot = m_slots[i];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == 0 || sequence % 2 != 0) {
+            continue;
+        }
+        const auto* name = slot.name.load(std::memory_order_relaxed);
+        const auto request = slot.request.load(std::memory_order_relaxed);
+        const auto thread = slot.thread.load(std::memory_order_relaxed);
+        const auto begin = slot.begin.load(std::memory_order_relaxed);
+        const auto end = slot.end.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // overwritten while it was read
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        auto event = nlohmann::json {
+            {"name", name},
+            {"ph", "X"},
+            {"ts", to_microseconds(begin)},
+            {"dur", to_microseconds(end - begin)},
+            {"pid", pid},
+            {"tid", thread},
+        };
+        if (request != 0) {
+            event["args"] = {{"request", request}};
+        }
+        events.push_back(std::move(event));
+    }
+    const nlohmann::json trace {
+        {"traceEvents", std::move(events)},
+        {"displayTimeUnit", "ms"},
+    };
+    return trace.dump();
+}
+
+Span::Span(const char* name) :
+    m_name(Tracer::enabled() ? name : nullptr),
+    m_begin(m_name ? Tracer::now() : 0) {}
+
+Span::~Span() {
+    if (m_name) {
+        Tracer::instance().record(m_name, m_begin, Tracer::now());
+    }
+}
+
+}  // namespace tracing
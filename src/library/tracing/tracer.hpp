@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file tracer.hpp
+ * @brief Spans of the request path, exported as a Chrome trace
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tracing {
+
+/**
+ * Keeps the latest spans in a ring buffer; older ones are overwritten. A
+ * writer claims a slot with one atomic add and marks it with a sequence
+ * number while it fills it in, so a dump running concurrently skips slots
+ * which are being written instead of locking them.
+ *
+ * Spans belong to the request the recording thread serves, which is set by
+ * begin_request() - the connection handler serves a connection, including a
+ * streamed body, on a single thread.
+ */
+class Tracer {
+  public:
+    static Tracer& instance();
+
+    // one relaxed load, checked before anything else is done for a span
+    static bool enabled() {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+    static void set_enabled(bool enabled);
+
+    // nanoseconds on the steady clock
+    static int64_t now();
+
+    // the following spans of this thread belong to a new request
+    static void begin_request();
+    // when the current request of this thread arrived, 0 without one
+    static int64_t request_begin();
+
+    // name must be a string literal, only the pointer is kept
+    void record(const char* name, int64_t begin, int64_t end);
+
+    // the buffered spans in the Chrome trace event format, which Perfetto
+    // and chrome://tracing open
+    std::string chrome_trace() const;
+
+  private:
+    Tracer();
+
+    struct Slot {
+        // odd while being written, 2 * (index + 1) once complete
+        std::atomic<uint64_t> sequence {0};
+        std::atomic<const char*> name {nullptr};
+        std::atomic<uint64_t> request {0};
+        std::atomic<int64_t> thread {0};
+        std::atomic<int64_t> begin {0};
+        std::atomic<int64_t> end {0};
+    };
+
+    static std::atomic<bool> s_enabled;
+
+    const size_t m_capacity;
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<uint64_t> m_next;
+};
+
+/**
+ * Records the time from its construction to its destruction. Does nothing
+ * when tracing is disabled at construction.
+ */
+class Span {
+  public:
+    explicit Span(const char* name);
+    ~Span();
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+  private:
+    const char* m_name;
+    int64_t m_begin;
+};
+
+}  // namespace tracing
+
+#ifdef HAILO_TRACING
+#define HAILO_TRACE_CONCAT_INNER(a, b) a##b
+#define HAILO_TRACE_CONCAT(a, b) HAILO_TRACE_CONCAT_INNER(a, b)
+// a span until the end of the enclosing scope
+#define TRACE_SPAN(name)                                                      \
+    const tracing::Span HAILO_TRACE_CONCAT(trace_span_, __LINE__)(name)
+// a span from the arrival of the current request until now
+#define TRACE_SINCE_REQUEST(name)                                             \
+    do {                                                                      \
+        if (tracing::Tracer::enabled()                                        \
+            && tracing::Tracer::request_begin() != 0) {                       \
+            tracing::Tracer::instance().record(                               \
+                name,                                                         \
+                tracing::Tracer::request_begin(),                             \
+                tracing::Tracer::now()                                        \
+            );                                                                \
+        }                                                                     \
+    } while (false)
+#else
+#define TRACE_SPAN(name) (void)0
+#define TRACE_SINCE_REQUEST(name) (void)0
+#endif
@@ -11,7 +11,11 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+#include "utils/split.hpp"
 
 namespace fs = std::filesystem;
 
@@ -35,6 +39,16 @@ fs::path config_home() {
     return fs::path(home != nullptr ? home : "") / XDG_CONFIG_HOME_SUFFIX;
 }
 
+fs::path cache_home() {
+    const auto value = std::getenv(XDG_CACHE_HOME);
+    if (value != nullptr && std::string_view(value) != "") {
+        return value;
+    }
+
+    auto home = std::getenv(HOME);
+    return fs::path(home != nullptr ? home : "") / XDG_CACHE_HOME_SUFFIX;
+}
+
 std::string system_config_home() {
     const auto value = std::getenv(XDG_CONFIG_DIRS);
     if (value == nullptr || std::string_view(value) == "") {
@@ -50,3 +64,31 @@ std::string system_data_home() {
     }
     return value;
 }
+
+fs::path
+find_dir(const fs::path& user_dir, const std::string& additional_dirs) {
+    std::vector<fs::path> options = {
+        user_dir,
+    };
+
+    for (const auto& path : SplitRange(additional_dirs, ":")) {
+        options.push_back(fs::path(path));
+    }
+
+    for (const auto& option : options) {
+        auto dir_path = option / HAILO_DIR_NAME;
+        const auto is_dir = fs::is_directory(fs::status(dir_path));
+        if (is_dir) {
+            return dir_path;
+        }
+    }
+    throw std::runtime_error("hailo-ollama directory not found");
+}
+
+fs::path find_config_dir() {
+    return find_dir(config_home(), system_config_home());
+}
+
+fs::path find_data_dir() {
+    return find_dir(data_home(), system_data_home());
+}
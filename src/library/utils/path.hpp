@@ -32,6 +32,7 @@ constexpr auto HAILO_CONFIG_NAME {"hailo-ollama.json"};
 constexpr auto HAILO_MODELS {"models"};
 constexpr auto HAILO_BLOB_DIR_NAME {"blob"};
 constexpr auto HAILO_MODEL_MANIFEST {"manifests"};
+constexpr auto HAILO_MANIFEST_INDEX {"manifests.index"};
 
 std::filesystem::path data_home();
 std::string system_data_home();
@@ -39,6 +40,17 @@ std::string system_data_home();
 std::filesystem::path config_home();
 std::string system_config_home();
 
+std::filesystem::path cache_home();
+
 std::filesystem::path model_manifest();
 
 std::filesystem::path data_dir();
+
+// the first hailo-ollama directory under user_dir or one of additional_dirs
+// (':' separated), throws if there is none
+std::filesystem::path find_dir(
+    const std::filesystem::path& user_dir,
+    const std::string& additional_dirs
+);
+std::filesystem::path find_config_dir();
+std::filesystem::path find_data_dir();
@@ -9,10 +9,26 @@
 
 #include "utils/sha256.hpp"
 
-#include <iomanip>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <future>
 #include <istream>
-#include <sstream>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include <openssl/evp.h>
@@ -54,22 +70,199 @@ std::string SHA256Hasher::finalize() {
         throw std::runtime_error("Failed to finalize digest");
     }
 
-    std::ostringstream oss;
-    for (unsigned char byte : hash) {
-        oss << std::hex << std::setw(2) << std::setfill('0')
-            << static_cast<int>(byte);
+    constexpr char digits[] = "0123456789abcdef";
+    std::string result(2 * length, '\0');
+    for (unsigned int i = 0; i < length; ++i) {
+        result[2 * i] = digits[hash[i] >> 4];
+        result[2 * i + 1] = digits[hash[i] & 0x0f];
     }
-    return oss.str();
+    return result;
 }
 
-std::string SHA256Hasher::hash(std::istream& stream) {
-    SHA256Hasher hasher;
+void SHA256Hasher::update(std::istream& stream) {
     std::vector<char> buffer(config::hash_buffer_size, '\0');
 
     while (stream) {
         stream.read(buffer.data(), buffer.size());
         auto count = stream.gcount();
-        hasher.update(buffer.data(), count);
+        update(buffer.data(), count);
+    }
+}
+
+namespace {
+class FileDescriptor {
+  public:
+    explicit FileDescriptor(const std::filesystem::path& path) :
+        m_fd(open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+        if (m_fd < 0) {
+            throw std::system_error(
+                errno,
+                std::generic_category(),
+                "Failed to open " + path.string()
+            );
+        }
+        (void)posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    ~FileDescriptor() {
+        (void)close(m_fd);
+    }
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int get() const {
+        return m_fd;
+    }
+
+  private:
+    int m_fd;
+};
+
+// fills the buffer unless the file ends first
+size_t read_chunk(
+    int fd,
+    char* data,
+    size_t size,
+    off_t offset,
+    const std::filesystem::path& path
+) {
+    size_t done = 0;
+    while (done < size) {
+        const auto count = pread(
+            fd,
+            data + done,
+            size - done,
+            offset + static_cast<off_t>(done)
+        );
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            throw std::system_error(
+                errno,
+                std::generic_category(),
+                "Failed to read " + path.string()
+            );
+        }
+        if (count == 0) {
+            break;
+        }
+        done += static_cast<size_t>(count);
+    }
+    return done;
+}
+}  // namespace
+
+void SHA256Hasher::update_file(
+    const std::filesystem::path& path,
+    FileRead strategy
+) {
+    const FileDescriptor file(path);
+    if (strategy == FileRead::MAPPED) {
+        update_mapped(file.get());
+        return;
+    }
+
+    if (strategy == FileRead::BUFFERED) {
+        std::vector<char> buffer(config::hash_buffer_size);
+        off_t offset = 0;
+        while (const auto count = read_chunk(
+                   file.get(),
+                   buffer.data(),
+                   buffer.size(),
+                   offset,
+                   path
+               )) {
+            update(buffer.data(), count);
+            offset += static_cast<off_t>(count);
+        }
+        return;
     }
+
+    std::vector<char> buffers[2] = {
+        std::vector<char>(config::hash_buffer_size),
+        std::vector<char>(config::hash_buffer_size),
+    };
+
+    const auto read_at = [&file, &path](std::vector<char>& buffer, off_t at) {
+        const auto read = [&file, &path, &buffer, at]() {
+            const auto fd = file.get();
+            return read_chunk(fd, buffer.data(), buffer.size(), at, path);
+        };
+        return std::async(std::launch::async, read);
+    };
+    size_t current = 0;
+    off_t offset = 0;
+    // the future of std::async waits for the read when it's destroyed, so
+    // an exception can't leave a read into freed buffers behind
+    auto pending = read_at(buffers[current], offset);
+    while (true) {
+        const auto count = pending.get();
+        if (count == 0) {
+            break;
+        }
+        offset += static_cast<off_t>(count);
+        // the next chunk is read while this one is hashed
+        pending = read_at(buffers[1 - current], offset);
+        update(buffers[current].data(), count);
+        current = 1 - current;
+    }
+}
+
+void SHA256Hasher::update_mapped(int fd) {
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        return;
+    }
+    const auto size = static_cast<size_t>(file_stat.st_size);
+    auto* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(
+            errno,
+            std::generic_category(),
+            "Failed to map the file"
+        );
+    }
+    (void)madvise(mapping, size, MADV_SEQUENTIAL);
+    const auto* data = static_cast<const char*>(mapping);
+    try {
+        for (size_t offset = 0; offset < size;
+             offset += config::hash_buffer_size) {
+            update(
+                data + offset,
+                std::min(config::hash_buffer_size, size - offset)
+            );
+        }
+    } catch (...) {
+        (void)munmap(mapping, size);
+        throw;
+    }
+    (void)munmap(mapping, size);
+}
+
+std::string SHA256Hasher::hash(std::istream& stream) {
+    SHA256Hasher hasher;
+    hasher.update(stream);
     return hasher.finalize();
 }
+
+std::string SHA256Hasher::hash_file(const std::filesystem::path& path) {
+    SHA256Hasher hasher;
+    hasher.update_file(path);
+    return hasher.finalize();
+}
+
+bool SHA256Hasher::hardware_accelerated() {
+#if defined(__x86_64__) || defined(__i386__)
+    // CPUID leaf 7, EBX bit 29: SHA extensions
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0
+        && (ebx & (1U << 29)) != 0;
+#elif defined(__aarch64__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return false;
+#endif
+}
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <filesystem>
 #include <istream>
 #include <memory>
 #include <string>
@@ -29,6 +30,9 @@ class ContextWrapper {
 class SHA256Hasher {
   public:
     static std::string hash(std::istream& stream);
+    static std::string hash_file(const std::filesystem::path& path);
+    // true if the CPU has SHA-256 instructions, which OpenSSL picks up
+    static bool hardware_accelerated();
 
     SHA256Hasher();
 
@@ -36,8 +40,29 @@ class SHA256Hasher {
 
     void update(const std::string& data);
 
+    // reads the stream until its end
+    void update(std::istream& stream);
+
+    enum class FileRead {
+        // one buffer, every read waits for the disk
+        BUFFERED,
+        // the next chunk is read with pread() while the last one is hashed
+        DOUBLE_BUFFERED,
+        // a read-only mapping: a file which is truncated or fails to read
+        // while it's hashed raises SIGBUS, so only for benchmarks
+        MAPPED,
+    };
+
+    void update_file(
+        const std::filesystem::path& path,
+        FileRead strategy = FileRead::DOUBLE_BUFFERED
+    );
+
     std::string finalize();
 
+  private:
+    void update_mapped(int fd);
+
   private:
     ContextWrapper m_context;
 };
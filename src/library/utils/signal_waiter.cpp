@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file signal_waiter.cpp
+ * @brief SignalWaiter implementation
+ **/
+
+#include "utils/signal_waiter.hpp"
+
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+namespace {
+[[noreturn]] void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+}  // namespace
+
+SignalWaiter::SignalWaiter(const std::vector<int>& signals) :
+    m_signal_fd(-1),
+    m_event_fd(-1) {
+    sigset_t mask;
+    (void)sigemptyset(&mask);
+    for (const auto signal : signals) {
+        (void)sigaddset(&mask, signal);
+    }
+    const auto error = pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+    if (error != 0) {
+        throw std::system_error(error, std::generic_category(), "sigmask");
+    }
+    m_signal_fd = signalfd(-1, &mask, SFD_CLOEXEC);
+    if (m_signal_fd < 0) {
+        throw_errno("signalfd");
+    }
+    m_event_fd = eventfd(0, EFD_CLOEXEC);
+    if (m_event_fd < 0) {
+        (void)close(m_signal_fd);
+        throw_errno("eventfd");
+    }
+}
+
+SignalWaiter::~SignalWaiter() {
+    (void)close(m_signal_fd);
+    (void)close(m_event_fd);
+}
+
+std::optional<int> SignalWaiter::wait() {
+    pollfd poll_fds[] = {{m_signal_fd, POLLIN, 0}, {m_event_fd, POLLIN, 0}};
+    while (true) {
+        if (poll(poll_fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_errno("poll");
+        }
+        if (poll_fds[1].revents & POLLIN) {
+            uint64_t count = 0;
+            (void)read(m_event_fd, &count, sizeof(count));
+            return std::nullopt;
+        }
+        signalfd_siginfo info {};
+        if (read(m_signal_fd, &info, sizeof(info)) == sizeof(info)) {
+            return static_cast<int>(info.ssi_signo);
+        }
+    }
+}
+
+void SignalWaiter::notify() {
+    const uint64_t count = 1;
+    (void)write(m_event_fd, &count, sizeof(count));
+}
+
+void SignalWaiter::restore(int signal) {
+    sigset_t mask;
+    (void)sigemptyset(&mask);
+    (void)sigaddset(&mask, signal);
+    (void)std::signal(signal, SIG_DFL);
+    (void)pthread_sigmask(SIG_UNBLOCK, &mask, nullptr);
+}
@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file signal_waiter.hpp
+ * @brief Waiting for signals and internal requests without polling
+ **/
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+/**
+ * Receives signals through a signalfd instead of a handler, so the waiting
+ * thread sleeps until one arrives. The signals are blocked in the thread
+ * which creates the waiter; threads created after it inherit the mask, so
+ * create it before any other thread. notify() wakes the waiter up from any
+ * thread through an eventfd.
+ */
+class SignalWaiter {
+  public:
+    explicit SignalWaiter(const std::vector<int>& signals);
+    ~SignalWaiter();
+
+    SignalWaiter(const SignalWaiter&) = delete;
+    SignalWaiter& operator=(const SignalWaiter&) = delete;
+
+    // the signal received, std::nullopt after notify()
+    std::optional<int> wait();
+    void notify();
+    // the signal takes its default action again in the calling thread
+    void restore(int signal);
+
+  private:
+    int m_signal_fd;
+    int m_event_fd;
+};
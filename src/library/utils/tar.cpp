@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file tar.cpp
+ * @brief TarReader implementation
+ **/
+
+#include "utils/tar.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+constexpr uint64_t block_size = 512;
+
+using Block = std::array<char, block_size>;
+
+// header fields: offset and length
+constexpr size_t name_offset = 0;
+constexpr size_t name_length = 100;
+constexpr size_t size_offset = 124;
+constexpr size_t size_length = 12;
+constexpr size_t checksum_offset = 148;
+constexpr size_t checksum_length = 8;
+constexpr size_t type_offset = 156;
+constexpr size_t magic_offset = 257;
+constexpr size_t prefix_offset = 345;
+constexpr size_t prefix_length = 155;
+
+std::string field(const Block& block, size_t offset, size_t length) {
+    const auto* begin = block.data() + offset;
+    return std::string(begin, std::find(begin, begin + length, '\0'));
+}
+
+uint64_t parse_number(const Block& block, size_t offset, size_t length) {
+    const auto* data = block.data() + offset;
+    uint64_t value = 0;
+    if (static_cast<unsigned char>(data[0]) & 0x80) {
+        // GNU base-256 for values which don't fit in octal
+        for (size_t i = 1; i < length; ++i) {
+            value = (value << 8) | static_cast<unsigned char>(data[i]);
+        }
+        return value;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] == ' ' && value == 0) {
+            continue;
+        }
+        if (data[i] < '0' || data[i] > '7') {
+            break;
+        }
+        value = value * 8 + static_cast<uint64_t>(data[i] - '0');
+    }
+    return value;
+}
+
+bool checksum_matches(const Block& block) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < block_size; ++i) {
+        const auto in_field =
+            i >= checksum_offset && i < checksum_offset + checksum_length;
+        sum += in_field ? ' ' : static_cast<unsigned char>(block[i]);
+    }
+    return sum == parse_number(block, checksum_offset, checksum_length);
+}
+
+uint64_t padding_of(uint64_t size) {
+    return (block_size - size % block_size) % block_size;
+}
+
+// pax records are "<length> <key>=<value>\n"
+void apply_pax(
+    std::string_view records,
+    std::optional<std::string>& path,
+    std::optional<uint64_t>& size
+) {
+    while (!records.empty()) {
+        const auto space = records.find(' ');
+        if (space == std::string_view::npos) {
+            break;
+        }
+        const auto length = std::stoull(std::string(records.substr(0, space)));
+        if (length <= space || length > records.size()) {
+            throw std::runtime_error("malformed pax header");
+        }
+        const auto record = records.substr(space + 1, length - space - 2);
+        records.remove_prefix(length);
+        const auto equals = record.find('=');
+        if (equals == std::string_view::npos) {
+            continue;
+        }
+        const auto key = record.substr(0, equals);
+        const auto value = record.substr(equals + 1);
+        if (key == "path") {
+            path = std::string(value);
+        } else if (key == "size") {
+            size = std::stoull(std::string(value));
+        }
+    }
+}
+}  // namespace
+
+TarReader::TarReader(std::istream& stream) :
+    m_stream(stream),
+    m_remaining(0),
+    m_padding(0) {}
+
+std::optional<TarEntry> TarReader::next() {
+    finish_entry();
+
+    std::optional<std::string> long_path;
+    std::optional<uint64_t> long_size;
+    while (true) {
+        Block block {};
+        if (!m_stream.read(block.data(), block.size())) {
+            throw std::runtime_error("truncated tar archive");
+        }
+        if (std::all_of(block.begin(), block.end(), [](char c) {
+                return c == '\0';
+            })) {
+            return std::nullopt;
+        }
+        if (!checksum_matches(block)) {
+            throw std::runtime_error(
+                "not a tar archive (compressed archives are not supported)"
+            );
+        }
+
+        const auto type = block[type_offset];
+        auto size = parse_number(block, size_offset, size_length);
+        if (type == 'L') {
+            // GNU long name for the next entry
+            auto name = read_all(size);
+            long_path = name.substr(0, name.find('\0'));
+            continue;
+        }
+        if (type == 'x') {
+            apply_pax(read_all(size), long_path, long_size);
+            continue;
+        }
+        if (type == 'g' || type == 'K') {
+            skip(size + padding_of(size));
+            continue;
+        }
+
+        std::string path;
+        if (long_path) {
+            path = *long_path;
+        } else {
+            path = field(block, name_offset, name_length);
+            const auto prefix = field(block, prefix_offset, prefix_length);
+            const auto ustar =
+                field(block, magic_offset, 5) == std::string("ustar");
+            if (ustar && !prefix.empty()) {
+                path = prefix + "/" + path;
+            }
+        }
+        if (long_size) {
+            size = *long_size;
+        }
+        const auto regular = type == '0' || type == '\0' || type == '7';
+        m_remaining = size;
+        m_padding = padding_of(size);
+        return TarEntry {std::move(path), size, regular};
+    }
+}
+
+size_t TarReader::read(char* buffer, size_t size) {
+    const auto count = std::min<uint64_t>(size, m_remaining);
+    if (count == 0) {
+        return 0;
+    }
+    if (!m_stream.read(buffer, static_cast<std::streamsize>(count))) {
+        throw std::runtime_error("truncated tar archive");
+    }
+    m_remaining -= count;
+    return count;
+}
+
+void TarReader::skip(uint64_t size) {
+    m_stream.ignore(static_cast<std::streamsize>(size));
+    if (static_cast<uint64_t>(m_stream.gcount()) != size) {
+        throw std::runtime_error("truncated tar archive");
+    }
+}
+
+std::string TarReader::read_all(uint64_t size) {
+    std::string data(size, '\0');
+    if (!m_stream.read(data.data(), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("truncated tar archive");
+    }
+    skip(padding_of(size));
+    return data;
+}
+
+void TarReader::finish_entry() {
+    skip(m_remaining + m_padding);
+    m_remaining = 0;
+    m_padding = 0;
+}
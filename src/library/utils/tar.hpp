@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2019-2025 Hailo Technologies Ltd. All rights reserved.
+ * Distributed under the MIT license (https://opensource.org/licenses/MIT)
+ **/
+/**
+ * @file tar.hpp
+ * @brief Sequential reading of tar archives
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+
+struct TarEntry {
+    std::string path;
+    uint64_t size;
+    // false for directories, links and other special entries
+    bool regular;
+};
+
+/**
+ * Reads an uncompressed ustar archive, including the GNU and pax extensions
+ * for long paths and large files, one entry after the other. The data is
+ * never buffered, so entries of any size can be streamed to their target.
+ */
+class TarReader {
+  public:
+    explicit TarReader(std::istream& stream);
+
+    // skips whatever is left of the current entry, std::nullopt at the end
+    std::optional<TarEntry> next();
+    // reads from the current entry, returns 0 at its end
+    size_t read(char* buffer, size_t size);
+
+  private:
+    void skip(uint64_t size);
+    std::string read_all(uint64_t size);
+    void finish_entry();
+
+  private:
+    std::istream& m_stream;
+    // left of the current entry, and its padding to the next block
+    uint64_t m_remaining;
+    uint64_t m_padding;
+};